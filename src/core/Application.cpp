@@ -27,6 +27,7 @@
 #include "HandlersManager.h"
 #include "HistoryManager.h"
 #include "LongTermTimer.h"
+#include "MemoryManager.h"
 #include "Migrator.h"
 #include "NetworkManagerFactory.h"
 #include "NotesManager.h"
@@ -426,6 +427,8 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv),
 
 	HistoryManager::createInstance();
 
+	MemoryManager::createInstance();
+
 	NetworkManagerFactory::createInstance();
 
 	NotesManager::createInstance();
@@ -1626,10 +1629,11 @@ QVector<MainWindow*> Application::getWindows()
 
 bool Application::canClose()
 {
-	if (TransfersManager::hasRunningTransfers() && SettingsManager::getOption(SettingsManager::Choices_WarnQuitTransfersOption).toBool())
+	if ((TransfersManager::hasRunningTransfers() || TransfersManager::hasQueuedTransfers()) && SettingsManager::getOption(SettingsManager::Choices_WarnQuitTransfersOption).toBool())
 	{
 		const QVector<Transfer*> transfers(TransfersManager::getTransfers());
 		int runningTransfers(0);
+		int queuedTransfers(0);
 
 		for (int i = 0; i < transfers.count(); ++i)
 		{
@@ -1637,11 +1641,15 @@ bool Application::canClose()
 			{
 				++runningTransfers;
 			}
+			else if (transfers.at(i)->getState() == Transfer::QueuedState)
+			{
+				++queuedTransfers;
+			}
 		}
 
 		QMessageBox messageBox;
 		messageBox.setWindowTitle(tr("Question"));
-		messageBox.setText(tr("You are about to quit while %n files are still being downloaded.", "", runningTransfers));
+		messageBox.setText((queuedTransfers > 0) ? tr("You are about to quit while %n files are still being downloaded or waiting in the queue.", "", (runningTransfers + queuedTransfers)) : tr("You are about to quit while %n files are still being downloaded.", "", runningTransfers));
 		messageBox.setInformativeText(tr("Do you want to continue?"));
 		messageBox.setIcon(QMessageBox::Question);
 		messageBox.setStandardButtons(QMessageBox::Yes | QMessageBox::Cancel);
@@ -22,11 +22,15 @@
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 
-#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
 #include <QtCore/QFile>
 #include <QtCore/QSaveFile>
 #include <QtCore/QTimerEvent>
 
+#define COOKIES_FILE_MAGIC static_cast<quint32>(0x4F434A32)
+#define COOKIES_FILE_VERSION static_cast<quint32>(1)
+#define COOKIES_JOURNAL_MINIMUM_SIZE 500
+
 namespace Otter
 {
 
@@ -35,49 +39,134 @@ CookieJar::CookieJar(const QString &path, QObject *parent) : QNetworkCookieJar(p
 	m_generalCookiesPolicy(AcceptAllCookies),
 	m_thirdPartyCookiesPolicy(AcceptAllCookies),
 	m_keepMode(KeepUntilExpiresMode),
-	m_saveTimer(0)
+	m_journalSize(0),
+	m_saveTimer(0),
+	m_needsCompaction(false)
 {
 	if (path.isEmpty())
 	{
 		return;
 	}
 
+	QHash<QString, QNetworkCookie> storedCookies;
 	QFile file(path);
 
-	if (!file.open(QIODevice::ReadOnly))
+	if (file.open(QIODevice::ReadOnly))
 	{
-		return;
-	}
+		QDataStream stream(&file);
+		quint32 header;
 
-	QDataStream stream(&file);
-	quint32 amount;
+		stream >> header;
 
-	stream >> amount;
+		if (header == COOKIES_FILE_MAGIC)
+		{
+			quint32 version;
+			quint32 amount;
 
-	QList<QNetworkCookie> allCookies;
-	allCookies.reserve(static_cast<int>(amount));
+			stream >> version >> amount;
 
-	for (quint32 i = 0; i < amount; ++i)
-	{
-		QByteArray value;
+			storedCookies.reserve(static_cast<int>(amount));
+
+			for (quint32 i = 0; i < amount; ++i)
+			{
+				QNetworkCookie cookie;
 
-		stream >> value;
+				readCookie(stream, &cookie);
 
-		const QList<QNetworkCookie> cookies(QNetworkCookie::parseCookies(value));
+				if (stream.status() != QDataStream::Ok)
+				{
+					break;
+				}
 
-		for (int j = 0; j < cookies.count(); ++j)
+				storedCookies[getCookieKey(cookie)] = cookie;
+			}
+		}
+		else
 		{
-			allCookies.append(cookies.at(j));
+			storedCookies.reserve(static_cast<int>(header));
+
+			for (quint32 i = 0; i < header; ++i)
+			{
+				QByteArray value;
+
+				stream >> value;
+
+				const QList<QNetworkCookie> cookies(QNetworkCookie::parseCookies(value));
+
+				for (int j = 0; j < cookies.count(); ++j)
+				{
+					storedCookies[getCookieKey(cookies.at(j))] = cookies.at(j);
+				}
+
+				if (stream.atEnd())
+				{
+					break;
+				}
+			}
+
+			m_needsCompaction = true;
 		}
 
-		if (stream.atEnd())
+		file.close();
+	}
+
+	QFile journalFile(getJournalPath());
+
+	if (journalFile.open(QIODevice::ReadOnly))
+	{
+		QDataStream stream(&journalFile);
+
+		while (!stream.atEnd())
 		{
-			break;
+			quint8 operation;
+			QNetworkCookie cookie;
+
+			stream >> operation;
+
+			readCookie(stream, &cookie);
+
+			if (stream.status() != QDataStream::Ok)
+			{
+				m_needsCompaction = true;
+
+				break;
+			}
+
+			if (static_cast<CookieOperation>(operation) == RemoveCookie)
+			{
+				storedCookies.remove(getCookieKey(cookie));
+			}
+			else
+			{
+				storedCookies[getCookieKey(cookie)] = cookie;
+			}
+
+			++m_journalSize;
+		}
+
+		journalFile.close();
+	}
+
+	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
+	QList<QNetworkCookie> cookies;
+	cookies.reserve(storedCookies.count());
+
+	QHash<QString, QNetworkCookie>::const_iterator iterator;
+
+	for (iterator = storedCookies.constBegin(); iterator != storedCookies.constEnd(); ++iterator)
+	{
+		if (iterator.value().isSessionCookie() || iterator.value().expirationDate() > currentDateTime)
+		{
+			cookies.append(iterator.value());
+		}
+		else
+		{
+			m_needsCompaction = true;
 		}
 	}
 
 	handleOptionChanged(SettingsManager::Network_CookiesPolicyOption, SettingsManager::getOption(SettingsManager::Network_CookiesPolicyOption));
-	setAllCookies(allCookies);
+	setAllCookies(cookies);
 
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &CookieJar::handleOptionChanged);
 }
@@ -109,6 +198,9 @@ void CookieJar::clearCookies(int period)
 		emit cookieRemoved(cookies.at(i));
 	}
 
+	m_pendingOperations.clear();
+	m_needsCompaction = true;
+
 	scheduleSave();
 }
 
@@ -127,6 +219,23 @@ void CookieJar::scheduleSave()
 	}
 }
 
+void CookieJar::queueOperation(CookieOperation operation, const QNetworkCookie &cookie)
+{
+	if (m_path.isEmpty())
+	{
+		return;
+	}
+
+	if (operation != RemoveCookie && cookie.isSessionCookie())
+	{
+		operation = RemoveCookie;
+	}
+
+	m_pendingOperations.append({operation, cookie});
+
+	scheduleSave();
+}
+
 void CookieJar::handleOptionChanged(int identifier, const QVariant &value)
 {
 	switch (identifier)
@@ -169,6 +278,50 @@ void CookieJar::save()
 		return;
 	}
 
+	if (m_needsCompaction || (m_journalSize + m_pendingOperations.count()) > qMax(COOKIES_JOURNAL_MINIMUM_SIZE, (allCookies().count() * 2)))
+	{
+		compact();
+
+		return;
+	}
+
+	if (m_pendingOperations.isEmpty())
+	{
+		return;
+	}
+
+	QFile file(getJournalPath());
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		return;
+	}
+
+	QDataStream stream(&file);
+
+	for (int i = 0; i < m_pendingOperations.count(); ++i)
+	{
+		stream << static_cast<quint8>(m_pendingOperations.at(i).first);
+
+		writeCookie(stream, m_pendingOperations.at(i).second);
+	}
+
+	file.close();
+
+	if (stream.status() == QDataStream::Ok && file.error() == QFileDevice::NoError)
+	{
+		m_journalSize += m_pendingOperations.count();
+
+		m_pendingOperations.clear();
+	}
+	else
+	{
+		m_needsCompaction = true;
+	}
+}
+
+void CookieJar::compact()
+{
 	QSaveFile file(m_path);
 
 	if (!file.open(QIODevice::WriteOnly))
@@ -177,18 +330,83 @@ void CookieJar::save()
 	}
 
 	const QList<QNetworkCookie> cookies(allCookies());
-	QDataStream stream(&file);
-	stream << static_cast<quint32>(cookies.count());
+	QVector<QNetworkCookie> persistentCookies;
+	persistentCookies.reserve(cookies.count());
 
 	for (int i = 0; i < cookies.count(); ++i)
 	{
 		if (!cookies.at(i).isSessionCookie())
 		{
-			stream << cookies.at(i).toRawForm();
+			persistentCookies.append(cookies.at(i));
 		}
 	}
 
-	file.commit();
+	QDataStream stream(&file);
+	stream << COOKIES_FILE_MAGIC << COOKIES_FILE_VERSION << static_cast<quint32>(persistentCookies.count());
+
+	for (int i = 0; i < persistentCookies.count(); ++i)
+	{
+		writeCookie(stream, persistentCookies.at(i));
+	}
+
+	if (!file.commit())
+	{
+		return;
+	}
+
+	QFile::remove(getJournalPath());
+
+	m_pendingOperations.clear();
+
+	m_journalSize = 0;
+	m_needsCompaction = false;
+}
+
+void CookieJar::readCookie(QDataStream &stream, QNetworkCookie *cookie)
+{
+	QByteArray name;
+	QByteArray value;
+	QString domain;
+	QString path;
+	qint64 expirationDate;
+	quint8 flags;
+
+	stream >> name >> value >> domain >> path >> expirationDate >> flags;
+
+	cookie->setName(name);
+	cookie->setValue(value);
+	cookie->setDomain(domain);
+	cookie->setPath(path);
+	cookie->setExpirationDate((expirationDate < 0) ? QDateTime() : QDateTime::fromMSecsSinceEpoch(expirationDate, Qt::UTC));
+	cookie->setSecure(flags & 1);
+	cookie->setHttpOnly(flags & 2);
+}
+
+void CookieJar::writeCookie(QDataStream &stream, const QNetworkCookie &cookie)
+{
+	quint8 flags(0);
+
+	if (cookie.isSecure())
+	{
+		flags |= 1;
+	}
+
+	if (cookie.isHttpOnly())
+	{
+		flags |= 2;
+	}
+
+	stream << cookie.name() << cookie.value() << cookie.domain() << cookie.path() << static_cast<qint64>(cookie.isSessionCookie() ? -1 : cookie.expirationDate().toMSecsSinceEpoch()) << flags;
+}
+
+QString CookieJar::getCookieKey(const QNetworkCookie &cookie)
+{
+	return cookie.domain() + QLatin1Char('\n') + cookie.path() + QLatin1Char('\n') + QString::fromLatin1(cookie.name());
+}
+
+QString CookieJar::getJournalPath() const
+{
+	return m_path + QLatin1String(".journal");
 }
 
 QString CookieJar::getPath() const
@@ -243,7 +461,7 @@ bool CookieJar::insertCookie(const QNetworkCookie &cookie)
 
 	if (result)
 	{
-		scheduleSave();
+		queueOperation(InsertCookie, cookie);
 
 		emit cookieAdded(cookie);
 	}
@@ -262,7 +480,7 @@ bool CookieJar::updateCookie(const QNetworkCookie &cookie)
 
 	if (result)
 	{
-		scheduleSave();
+		queueOperation(UpdateCookie, cookie);
 	}
 
 	return result;
@@ -279,7 +497,7 @@ bool CookieJar::deleteCookie(const QNetworkCookie &cookie)
 
 	if (result)
 	{
-		scheduleSave();
+		queueOperation(RemoveCookie, cookie);
 
 		emit cookieRemoved(cookie);
 	}
@@ -293,7 +511,7 @@ bool CookieJar::forceInsertCookie(const QNetworkCookie &cookie)
 
 	if (result)
 	{
-		scheduleSave();
+		queueOperation(InsertCookie, cookie);
 
 		emit cookieAdded(cookie);
 	}
@@ -307,7 +525,7 @@ bool CookieJar::forceUpdateCookie(const QNetworkCookie &cookie)
 
 	if (result)
 	{
-		scheduleSave();
+		queueOperation(UpdateCookie, cookie);
 	}
 
 	return result;
@@ -319,7 +537,7 @@ bool CookieJar::forceDeleteCookie(const QNetworkCookie &cookie)
 
 	if (result)
 	{
-		scheduleSave();
+		queueOperation(RemoveCookie, cookie);
 
 		emit cookieRemoved(cookie);
 	}
@@ -20,6 +20,7 @@
 #ifndef OTTER_COOKIEJAR_H
 #define OTTER_COOKIEJAR_H
 
+#include <QtCore/QDataStream>
 #include <QtNetwork/QNetworkCookie>
 #include <QtNetwork/QNetworkCookieJar>
 
@@ -72,17 +73,26 @@ public:
 protected:
 	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
+	void queueOperation(CookieOperation operation, const QNetworkCookie &cookie);
 	void save();
+	void compact();
+	QString getJournalPath() const;
+	static void readCookie(QDataStream &stream, QNetworkCookie *cookie);
+	static void writeCookie(QDataStream &stream, const QNetworkCookie &cookie);
+	static QString getCookieKey(const QNetworkCookie &cookie);
 
 protected slots:
 	void handleOptionChanged(int identifier, const QVariant &value);
 
 private:
 	QString m_path;
+	QVector<QPair<CookieOperation, QNetworkCookie> > m_pendingOperations;
 	CookiesPolicy m_generalCookiesPolicy;
 	CookiesPolicy m_thirdPartyCookiesPolicy;
 	KeepMode m_keepMode;
+	int m_journalSize;
 	int m_saveTimer;
+	bool m_needsCompaction;
 
 signals:
 	void cookieAdded(QNetworkCookie cookie);
@@ -24,20 +24,166 @@
 #include "SettingsManager.h"
 #include "Utils.h"
 
-#include <QtCore/QEventLoop>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
 #include <QtCore/QFileInfo>
+#include <QtCore/QPointer>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QTimer>
 #include <QtNetwork/QHostInfo>
 
+#define HOST_LOOKUP_INVALID_TIME_LIMIT 60000
+#define HOST_LOOKUP_PREFETCH_DELAY 150
+#define HOST_LOOKUP_VALID_TIME_LIMIT 300000
+
 namespace Otter
 {
 
+QTimer* InputInterpreter::m_prefetchTimer(nullptr);
+QString InputInterpreter::m_prefetchText;
+QHash<QString, InputInterpreter::HostInformation> InputInterpreter::m_hosts;
+QHash<QString, QVector<std::function<void(bool)> > > InputInterpreter::m_hostLookups;
+
 InputInterpreter::InputInterpreter(QObject *parent) : QObject(parent)
 {
 }
 
+void InputInterpreter::interpret(const QString &text, InterpreterFlags flags, QObject *context, const std::function<void(const InterpreterResult &result)> &callback)
+{
+	QString host;
+	const InterpreterResult result(interpret(text, flags, &host));
+	const int lookupTimeout(SettingsManager::getOption(SettingsManager::AddressField_HostLookupTimeoutOption).toInt());
+
+	if (host.isEmpty() || lookupTimeout <= 0)
+	{
+		callback(result);
+
+		return;
+	}
+
+	const QPointer<QObject> contextPointer(context);
+	QSharedPointer<bool> isFinished(new bool(false));
+	const std::function<void(bool)> handleLookupFinished([=](bool isValid)
+	{
+		if (*isFinished || !contextPointer)
+		{
+			return;
+		}
+
+		*isFinished = true;
+
+		if (isValid)
+		{
+			InterpreterResult urlResult;
+			urlResult.url = QUrl::fromUserInput(text);
+			urlResult.type = InterpreterResult::UrlType;
+
+			callback(urlResult);
+		}
+		else
+		{
+			callback(result);
+		}
+	});
+
+	m_hostLookups[host].append(handleLookupFinished);
+
+	QTimer::singleShot(lookupTimeout, context, [=]()
+	{
+		handleLookupFinished(false);
+	});
+
+	lookupHost(host);
+}
+
+void InputInterpreter::prefetchHost(const QString &text)
+{
+	if (SettingsManager::getOption(SettingsManager::AddressField_HostLookupTimeoutOption).toInt() <= 0)
+	{
+		return;
+	}
+
+	if (!m_prefetchTimer)
+	{
+		m_prefetchTimer = new QTimer(QCoreApplication::instance());
+		m_prefetchTimer->setInterval(HOST_LOOKUP_PREFETCH_DELAY);
+		m_prefetchTimer->setSingleShot(true);
+
+		QObject::connect(m_prefetchTimer, &QTimer::timeout, m_prefetchTimer, [&]()
+		{
+			QString host;
+
+			interpret(m_prefetchText, NoFlags, &host);
+
+			if (!host.isEmpty())
+			{
+				lookupHost(host);
+			}
+		});
+	}
+
+	m_prefetchText = text.trimmed();
+	m_prefetchTimer->start();
+}
+
+void InputInterpreter::lookupHost(const QString &host)
+{
+#if QT_VERSION >= 0x050900
+	if (m_hosts.contains(host) && m_hosts[host].expirationTime > QDateTime::currentMSecsSinceEpoch())
+	{
+		handleHostLookupFinished(host, m_hosts[host].isValid);
+
+		return;
+	}
+
+	if (m_hosts.contains(host) && m_hosts[host].expirationTime == 0)
+	{
+		return;
+	}
+
+	m_hosts[host] = HostInformation();
+
+	QHostInfo::lookupHost(host, QCoreApplication::instance(), [=](const QHostInfo &information)
+	{
+		const bool isValid(information.error() == QHostInfo::NoError && !information.addresses().isEmpty());
+		HostInformation hostInformation;
+		hostInformation.expirationTime = (QDateTime::currentMSecsSinceEpoch() + (isValid ? HOST_LOOKUP_VALID_TIME_LIMIT : HOST_LOOKUP_INVALID_TIME_LIMIT));
+		hostInformation.isValid = isValid;
+
+		m_hosts[host] = hostInformation;
+
+		handleHostLookupFinished(host, isValid);
+	});
+#else
+	handleHostLookupFinished(host, false);
+#endif
+}
+
+void InputInterpreter::handleHostLookupFinished(const QString &host, bool isValid)
+{
+	const QVector<std::function<void(bool)> > callbacks(m_hostLookups.take(host));
+
+	for (int i = 0; i < callbacks.count(); ++i)
+	{
+		callbacks.at(i)(isValid);
+	}
+}
+
 InputInterpreter::InterpreterResult InputInterpreter::interpret(const QString &text, InterpreterFlags flags)
+{
+	QString host;
+	const InterpreterResult result(interpret(text, flags, &host));
+
+	if (!host.isEmpty())
+	{
+		lookupHost(host);
+	}
+
+	return result;
+}
+
+InputInterpreter::InterpreterResult InputInterpreter::interpret(const QString &text, InterpreterFlags flags, QString *host)
 {
 	InterpreterResult result;
 
@@ -125,49 +271,23 @@ InputInterpreter::InterpreterResult InputInterpreter::interpret(const QString &t
 		return result;
 	}
 
-#if QT_VERSION >= 0x050900
-	if (!flags.testFlag(NoHostLookupFlag))
+	if (!flags.testFlag(NoHostLookupFlag) && url.isValid() && !url.host().isEmpty())
 	{
-		const int lookupTimeout(SettingsManager::getOption(SettingsManager::AddressField_HostLookupTimeoutOption).toInt());
+		const HostInformation information(m_hosts.value(url.host()));
 
-		if (url.isValid() && lookupTimeout > 0)
+		if (information.isValid && information.expirationTime > QDateTime::currentMSecsSinceEpoch())
 		{
-			QEventLoop eventLoop;
-			const int lookupIdentifier(QHostInfo::lookupHost(url.host(), [&](const QHostInfo &information)
-			{
-				if (information.error() == QHostInfo::NoError)
-				{
-					result.url = QUrl::fromUserInput(text);
-					result.type = InterpreterResult::UrlType;
-				}
-
-				eventLoop.quit();
-			}));
-
-			QTimer timer;
-			timer.setSingleShot(true);
-
-			connect(&timer, &QTimer::timeout, [&]()
-			{
-				QHostInfo::abortHostLookup(lookupIdentifier);
+			result.url = url;
+			result.type = InterpreterResult::UrlType;
 
-				eventLoop.quit();
-			});
-
-			timer.start(lookupTimeout);
-
-			if (result.type == InterpreterResult::UnknownType)
-			{
-				eventLoop.exec();
-			}
+			return result;
+		}
 
-			if (result.type == InterpreterResult::UrlType)
-			{
-				return result;
-			}
+		if (information.expirationTime <= QDateTime::currentMSecsSinceEpoch() && host)
+		{
+			*host = url.host();
 		}
 	}
-#endif
 
 	result.searchQuery = text;
 	result.type = InterpreterResult::SearchType;
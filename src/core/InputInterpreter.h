@@ -23,6 +23,8 @@
 
 #include "BookmarksModel.h"
 
+#include <functional>
+
 namespace Otter
 {
 
@@ -65,7 +67,26 @@ public:
 
 	explicit InputInterpreter(QObject *parent = nullptr);
 
+	static void interpret(const QString &text, InterpreterFlags flags, QObject *context, const std::function<void(const InterpreterResult &result)> &callback);
+	static void prefetchHost(const QString &text);
 	static InterpreterResult interpret(const QString &text, InterpreterFlags flags = NoFlags);
+
+protected:
+	struct HostInformation final
+	{
+		qint64 expirationTime = 0;
+		bool isValid = false;
+	};
+
+	static void lookupHost(const QString &host);
+	static void handleHostLookupFinished(const QString &host, bool isValid);
+	static InterpreterResult interpret(const QString &text, InterpreterFlags flags, QString *host);
+
+private:
+	static QTimer *m_prefetchTimer;
+	static QString m_prefetchText;
+	static QHash<QString, HostInformation> m_hosts;
+	static QHash<QString, QVector<std::function<void(bool)> > > m_hostLookups;
 };
 
 }
@@ -231,7 +231,7 @@ bool JsonSettings::save(const QString &path, bool isAtomic)
 	{
 		m_hasError = true;
 
-		file->deleteLater();
+		delete file;
 
 		return false;
 	}
@@ -310,7 +310,7 @@ bool JsonSettings::save(const QString &path, bool isAtomic)
 		file->close();
 	}
 
-	file->deleteLater();
+	delete file;
 
 	return result;
 }
@@ -0,0 +1,196 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2020 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "MemoryManager.h"
+#include "Application.h"
+#include "SettingsManager.h"
+#include "Utils.h"
+#include "../ui/MainWindow.h"
+#include "../ui/Window.h"
+
+#include <QtCore/QTimerEvent>
+
+#define MEMORY_CHECK_INTERVAL 10000
+#define MEMORY_TARGET_PERCENT 90
+
+namespace Otter
+{
+
+MemoryManager* MemoryManager::m_instance(nullptr);
+MemoryManager::Statistics MemoryManager::m_statistics;
+qint64 MemoryManager::m_memoryUsage(-1);
+
+MemoryManager::MemoryManager(QObject *parent) : QObject(parent),
+	m_lastSuspensionMemoryUsage(-1),
+	m_checkTimer(0)
+{
+	updateTimer();
+
+	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &MemoryManager::handleOptionChanged);
+}
+
+void MemoryManager::createInstance()
+{
+	if (!m_instance)
+	{
+		m_instance = new MemoryManager(QCoreApplication::instance());
+	}
+}
+
+void MemoryManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_checkTimer)
+	{
+		checkMemoryUsage();
+	}
+}
+
+void MemoryManager::checkMemoryUsage()
+{
+	const qint64 limit(SettingsManager::getOption(SettingsManager::Browser_MemoryUsageLimitOption).toLongLong() * 1048576);
+
+	m_memoryUsage = Utils::getProcessMemoryUsage();
+
+	if (m_memoryUsage < 0)
+	{
+		return;
+	}
+
+	if (m_lastSuspensionMemoryUsage >= 0)
+	{
+		if (m_lastSuspensionMemoryUsage > m_memoryUsage)
+		{
+			m_statistics.measuredReclaimedMemory += (m_lastSuspensionMemoryUsage - m_memoryUsage);
+		}
+
+		m_lastSuspensionMemoryUsage = -1;
+	}
+
+	if (limit <= 0 || m_memoryUsage <= limit)
+	{
+		return;
+	}
+
+	const QVector<MainWindow*> mainWindows(Application::getWindows());
+	QVector<Window*> windows;
+
+	for (int i = 0; i < mainWindows.count(); ++i)
+	{
+		const MainWindow *mainWindow(mainWindows.at(i));
+		const Window *activeWindow(mainWindow->getActiveWindow());
+
+		for (int j = 0; j < mainWindow->getWindowCount(); ++j)
+		{
+			Window *window(mainWindow->getWindowByIndex(j));
+
+			if (!window || window == activeWindow || window->isPinned() || window->isAboutToClose() || window->getLoadingState() == WebWidget::DeferredLoadingState)
+			{
+				continue;
+			}
+
+			const WebWidget *webWidget(window->getWebWidget());
+
+			if (!webWidget || !webWidget->isAudible())
+			{
+				windows.append(window);
+			}
+		}
+	}
+
+	std::sort(windows.begin(), windows.end(), [&](const Window *first, const Window *second)
+	{
+		return (first->getLastActivity() < second->getLastActivity());
+	});
+
+	const qint64 target((limit * MEMORY_TARGET_PERCENT) / 100);
+	qint64 estimatedMemory(0);
+	int amount(0);
+
+	for (int i = 0; i < windows.count(); ++i)
+	{
+		if ((m_memoryUsage - estimatedMemory) <= target)
+		{
+			break;
+		}
+
+		Window *window(windows.at(i));
+		const WebWidget *webWidget(window->getWebWidget());
+		const qint64 windowMemory(webWidget ? webWidget->getEstimatedMemoryUsage() : 0);
+
+		window->triggerAction(ActionsManager::SuspendTabAction);
+
+		if (window->getLoadingState() == WebWidget::DeferredLoadingState)
+		{
+			estimatedMemory += windowMemory;
+
+			++amount;
+		}
+	}
+
+	if (amount > 0)
+	{
+		m_lastSuspensionMemoryUsage = m_memoryUsage;
+
+		m_statistics.estimatedReclaimedMemory += estimatedMemory;
+		m_statistics.suspendedTabs += amount;
+
+		emit tabsSuspended(amount, estimatedMemory);
+	}
+}
+
+void MemoryManager::updateTimer()
+{
+	const bool isEnabled(SettingsManager::getOption(SettingsManager::Browser_MemoryUsageLimitOption).toInt() > 0);
+
+	if (isEnabled && m_checkTimer == 0)
+	{
+		m_checkTimer = startTimer(MEMORY_CHECK_INTERVAL);
+	}
+	else if (!isEnabled && m_checkTimer != 0)
+	{
+		killTimer(m_checkTimer);
+
+		m_checkTimer = 0;
+	}
+}
+
+void MemoryManager::handleOptionChanged(int identifier)
+{
+	if (identifier == SettingsManager::Browser_MemoryUsageLimitOption)
+	{
+		updateTimer();
+	}
+}
+
+MemoryManager* MemoryManager::getInstance()
+{
+	return m_instance;
+}
+
+MemoryManager::Statistics MemoryManager::getStatistics()
+{
+	return m_statistics;
+}
+
+qint64 MemoryManager::getMemoryUsage()
+{
+	return m_memoryUsage;
+}
+
+}
@@ -0,0 +1,71 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2020 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_MEMORYMANAGER_H
+#define OTTER_MEMORYMANAGER_H
+
+#include <QtCore/QObject>
+
+namespace Otter
+{
+
+class MemoryManager final : public QObject
+{
+	Q_OBJECT
+
+public:
+	struct Statistics final
+	{
+		qint64 estimatedReclaimedMemory = 0;
+		qint64 measuredReclaimedMemory = 0;
+		int suspendedTabs = 0;
+	};
+
+	static void createInstance();
+	static MemoryManager* getInstance();
+	static Statistics getStatistics();
+	static qint64 getMemoryUsage();
+
+public slots:
+	void checkMemoryUsage();
+
+protected:
+	explicit MemoryManager(QObject *parent);
+
+	void timerEvent(QTimerEvent *event) override;
+	void updateTimer();
+
+protected slots:
+	void handleOptionChanged(int identifier);
+
+private:
+	qint64 m_lastSuspensionMemoryUsage;
+	int m_checkTimer;
+
+	static MemoryManager *m_instance;
+	static Statistics m_statistics;
+	static qint64 m_memoryUsage;
+
+signals:
+	void tabsSuspended(int amount, qint64 estimatedMemory);
+};
+
+}
+
+#endif
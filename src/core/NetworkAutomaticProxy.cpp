@@ -25,34 +25,58 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDate>
 #include <QtCore/QFile>
-#include <QtNetwork/QHostInfo>
+#include <QtCore/QMutexLocker>
 #include <QtNetwork/QNetworkInterface>
 
+#define PAC_HOSTS_CACHE_LIMIT 1000
+#define PAC_HOST_INVALID_TIME_LIMIT 10000
+#define PAC_HOST_VALID_TIME_LIMIT 60000
+#define PAC_PROXIES_CACHE_LIMIT 500
+#define PAC_PROXY_TIME_LIMIT 60000
+
 namespace Otter
 {
 
 QStringList PacUtils::m_months = {QLatin1String("jan"), QLatin1String("feb"), QLatin1String("mar"), QLatin1String("apr"), QLatin1String("may"), QLatin1String("jun"), QLatin1String("jul"), QLatin1String("aug"), QLatin1String("sep"), QLatin1String("oct"), QLatin1String("nov"), QLatin1String("dec")};
 QStringList PacUtils::m_days = {QLatin1String("mon"), QLatin1String("tue"), QLatin1String("wed"), QLatin1String("thu"), QLatin1String("fri"), QLatin1String("sat"), QLatin1String("sun")};
+QHash<QString, PacUtils::HostInformation> PacUtils::m_hosts;
+QMutex PacUtils::m_hostsMutex;
 
 PacUtils::PacUtils(QObject *parent) : QObject(parent)
 {
 }
 
-void PacUtils::alert(const QString &message) const
+void PacUtils::cacheHost(const QHostInfo &hostInformation)
 {
-	Console::addMessage(message, Console::NetworkCategory, Console::WarningLevel);
-}
+	HostInformation information;
 
-QString PacUtils::dnsResolve(const QString &host) const
-{
-	const QHostInfo hostInformation(QHostInfo::fromName(host));
+	if (hostInformation.error() == QHostInfo::NoError)
+	{
+		information.addresses = hostInformation.addresses();
+	}
+
+	information.expirationTime = (QDateTime::currentMSecsSinceEpoch() + (information.addresses.isEmpty() ? PAC_HOST_INVALID_TIME_LIMIT : PAC_HOST_VALID_TIME_LIMIT));
+
+	QMutexLocker locker(&m_hostsMutex);
 
-	if (hostInformation.error() == QHostInfo::NoError && !hostInformation.addresses().isEmpty())
+	if (m_hosts.count() >= PAC_HOSTS_CACHE_LIMIT)
 	{
-		return hostInformation.addresses().value(0).toString();
+		m_hosts.clear();
 	}
 
-	return {};
+	m_hosts[hostInformation.hostName().toLower()] = information;
+}
+
+void PacUtils::alert(const QString &message)
+{
+	emit alertRequested(message);
+}
+
+QString PacUtils::dnsResolve(const QString &host) const
+{
+	const QList<QHostAddress> addresses(resolveHost(host));
+
+	return (addresses.isEmpty() ? QString() : addresses.first().toString());
 }
 
 QString PacUtils::myIpAddress() const
@@ -82,7 +106,13 @@ int PacUtils::dnsDomainLevels(const QString &host) const
 
 bool PacUtils::isInNet(const QString &host, const QString &pattern, const QString &mask) const
 {
-	const QHostAddress address(host);
+	QHostAddress address(host);
+
+	if (address.isNull())
+	{
+		address = resolveHost(host).value(0);
+	}
+
 	const QHostAddress netaddress(pattern);
 	const QHostAddress netmask(mask);
 
@@ -96,7 +126,7 @@ bool PacUtils::isPlainHostName(const QString &host) const
 
 bool PacUtils::isResolvable(const QString &host) const
 {
-	return (QHostInfo::fromName(host).error() == QHostInfo::NoError);
+	return !resolveHost(host).isEmpty();
 }
 
 bool PacUtils::localHostOrDomainIs(const QString &host, QString domain) const
@@ -300,25 +330,198 @@ bool PacUtils::isNumberInRange(int from, int to, int value) const
 	return (value >= from && value <= to);
 }
 
-NetworkAutomaticProxy::NetworkAutomaticProxy(const QString &path, QObject *parent) : QObject(parent),
-	m_path(path),
-	m_isValid(false)
+bool PacUtils::hasHost(const QString &host)
+{
+	QMutexLocker locker(&m_hostsMutex);
+
+	return (m_hosts.contains(host.toLower()) && m_hosts[host.toLower()].expirationTime > QDateTime::currentMSecsSinceEpoch());
+}
+
+QList<QHostAddress> PacUtils::resolveHost(const QString &host)
+{
+	const QString normalizedHost(host.toLower());
+
+	{
+		QMutexLocker locker(&m_hostsMutex);
+
+		if (m_hosts.contains(normalizedHost) && m_hosts[normalizedHost].expirationTime > QDateTime::currentMSecsSinceEpoch())
+		{
+			return m_hosts[normalizedHost].addresses;
+		}
+	}
+
+	QHostInfo hostInformation(QHostInfo::fromName(host));
+	hostInformation.setHostName(normalizedHost);
+
+	cacheHost(hostInformation);
+
+	return ((hostInformation.error() == QHostInfo::NoError) ? hostInformation.addresses() : QList<QHostAddress>());
+}
+
+PacEvaluator::PacEvaluator(QObject *parent) : QObject(parent),
+	m_engine(nullptr)
+{
+}
+
+void PacEvaluator::prefetchProxy(const QString &key, const QString &url, const QString &host)
 {
-	m_engine.globalObject().setProperty(QLatin1String("PacUtils"), m_engine.newQObject(new PacUtils(this)));
+	emit proxyPrefetched(key, findProxy(url, host));
+}
+
+QString PacEvaluator::findProxy(const QString &url, const QString &host)
+{
+	if (!m_engine || !m_findProxy.isCallable())
+	{
+		return QLatin1String("ERROR");
+	}
+
+	const QJSValue result(m_findProxy.call(QJSValueList({m_engine->toScriptValue(url), m_engine->toScriptValue(host)})));
+
+	if (result.isError())
+	{
+		return QLatin1String("ERROR");
+	}
+
+	return result.toString().remove(QLatin1Char(' '));
+}
+
+bool PacEvaluator::setup(const QString &script)
+{
+	if (m_engine)
+	{
+		m_engine->deleteLater();
+	}
+
+	m_engine = new QJSEngine(this);
+	m_findProxy = QJSValue();
+
+	PacUtils *utils(new PacUtils(m_engine));
+
+	connect(utils, &PacUtils::alertRequested, this, &PacEvaluator::alertRequested);
+
+	m_engine->globalObject().setProperty(QLatin1String("PacUtils"), m_engine->newQObject(utils));
 
 	const QStringList functions({QLatin1String("alert"), QLatin1String("dnsResolve"), QLatin1String("myIpAddress"), QLatin1String("dnsDomainLevels"), QLatin1String("isInNet"), QLatin1String("isPlainHostName"), QLatin1String("isResolvable"), QLatin1String("localHostOrDomainIs"), QLatin1String("dnsDomainIs"), QLatin1String("shExpMatch"), QLatin1String("weekdayRange"), QLatin1String("dateRange"), QLatin1String("timeRange")});
 
 	for (int i = 0; i < functions.count(); ++i)
 	{
-		m_engine.evaluate(QStringLiteral("function %1() { return PacUtils.%1.apply(null, arguments); }").arg(functions.at(i))).isError();
+		m_engine->evaluate(QStringLiteral("function %1() { return PacUtils.%1.apply(null, arguments); }").arg(functions.at(i))).isError();
+	}
+
+	if (m_engine->evaluate(script).isError())
+	{
+		return false;
 	}
 
+	m_findProxy = m_engine->globalObject().property(QLatin1String("FindProxyForURL"));
+
+	return m_findProxy.isCallable();
+}
+
+NetworkAutomaticProxy::NetworkAutomaticProxy(const QString &path, QObject *parent) : QObject(parent),
+	m_evaluator(new PacEvaluator()),
+	m_path(path),
+	m_isValid(false)
+{
 	m_proxies.insert(QLatin1String("ERROR"), QVector<QNetworkProxy>({QNetworkProxy(QNetworkProxy::DefaultProxy)}));
 	m_proxies.insert(QLatin1String("DIRECT"), QVector<QNetworkProxy>({QNetworkProxy(QNetworkProxy::NoProxy)}));
 
+	m_evaluator->moveToThread(&m_thread);
+
+	connect(&m_thread, &QThread::finished, m_evaluator, &PacEvaluator::deleteLater);
+	connect(m_evaluator, &PacEvaluator::alertRequested, this, [&](const QString &message)
+	{
+		Console::addMessage(message, Console::NetworkCategory, Console::WarningLevel);
+	});
+	connect(m_evaluator, &PacEvaluator::proxyPrefetched, this, [&](const QString &key, const QString &configuration)
+	{
+		m_prefetches.remove(key);
+
+		cacheProxy(key, configuration);
+	});
+
+	m_thread.start();
+
 	setPath(path);
 }
 
+NetworkAutomaticProxy::~NetworkAutomaticProxy()
+{
+	m_thread.quit();
+	m_thread.wait();
+}
+
+void NetworkAutomaticProxy::prefetchProxy(const QUrl &url)
+{
+	const QString host(url.host());
+
+	if (!m_isValid || host.isEmpty())
+	{
+		return;
+	}
+
+	const QString key(getCacheKey(url, host));
+
+	if (m_prefetches.contains(key))
+	{
+		return;
+	}
+
+	{
+		QMutexLocker locker(&m_mutex);
+
+		if (m_cache.contains(key) && m_cache[key].expirationTime > QDateTime::currentMSecsSinceEpoch())
+		{
+			return;
+		}
+	}
+
+	m_prefetches.insert(key);
+
+	const QString urlString(url.toString());
+	const auto evaluateProxy([=]()
+	{
+		QMetaObject::invokeMethod(m_evaluator, "prefetchProxy", Qt::QueuedConnection, Q_ARG(QString, key), Q_ARG(QString, urlString), Q_ARG(QString, host));
+	});
+
+#if QT_VERSION >= 0x050900
+	if (QHostAddress(host).isNull() && !PacUtils::hasHost(host))
+	{
+		QHostInfo::lookupHost(host, this, [=](const QHostInfo &hostInformation)
+		{
+			PacUtils::cacheHost(hostInformation);
+
+			evaluateProxy();
+		});
+
+		return;
+	}
+#endif
+
+	evaluateProxy();
+}
+
+void NetworkAutomaticProxy::cacheProxy(const QString &key, const QString &configuration)
+{
+	if (configuration == QLatin1String("ERROR"))
+	{
+		return;
+	}
+
+	ProxyInformation information;
+	information.proxies = parseProxy(configuration);
+	information.expirationTime = (QDateTime::currentMSecsSinceEpoch() + PAC_PROXY_TIME_LIMIT);
+
+	QMutexLocker locker(&m_mutex);
+
+	if (m_cache.count() >= PAC_PROXIES_CACHE_LIMIT)
+	{
+		m_cache.clear();
+	}
+
+	m_cache[key] = information;
+}
+
 void NetworkAutomaticProxy::setPath(const QString &path)
 {
 	if (QFile::exists(path))
@@ -372,16 +575,48 @@ QString NetworkAutomaticProxy::getPath() const
 	return m_path;
 }
 
-QVector<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const QString &host)
+QString NetworkAutomaticProxy::evaluateProxy(const QString &url, const QString &host)
 {
-	const QJSValue result(m_findProxy.call(QJSValueList({m_engine.toScriptValue(url), m_engine.toScriptValue(host)})));
+	if (QThread::currentThread() == &m_thread)
+	{
+		return m_evaluator->findProxy(url, host);
+	}
+
+	QString configuration;
+
+	QMetaObject::invokeMethod(m_evaluator, "findProxy", Qt::BlockingQueuedConnection, Q_RETURN_ARG(QString, configuration), Q_ARG(QString, url), Q_ARG(QString, host));
+
+	return configuration;
+}
+
+QString NetworkAutomaticProxy::getCacheKey(const QUrl &url, const QString &host)
+{
+	return url.scheme() + QLatin1String("://") + host.toLower();
+}
+
+QVector<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QUrl &url, const QString &host)
+{
+	const QString key(getCacheKey(url, host));
 
-	if (result.isError())
 	{
-		return m_proxies[QLatin1String("ERROR")];
+		QMutexLocker locker(&m_mutex);
+
+		if (m_cache.contains(key) && m_cache[key].expirationTime > QDateTime::currentMSecsSinceEpoch())
+		{
+			return m_cache[key].proxies;
+		}
 	}
 
-	const QString configuration(result.toString().remove(QLatin1Char(' ')));
+	const QString configuration(evaluateProxy(url.toString(), host));
+
+	cacheProxy(key, configuration);
+
+	return parseProxy(configuration);
+}
+
+QVector<QNetworkProxy> NetworkAutomaticProxy::parseProxy(const QString &configuration)
+{
+	QMutexLocker locker(&m_mutex);
 
 	if (!m_proxies.value(configuration).isEmpty())
 	{
@@ -436,14 +671,15 @@ bool NetworkAutomaticProxy::isValid() const
 
 bool NetworkAutomaticProxy::setup(const QString &script)
 {
-	if (m_engine.evaluate(script).isError())
-	{
-		return false;
-	}
+	bool isSuccess(false);
 
-	m_findProxy = m_engine.globalObject().property(QLatin1String("FindProxyForURL"));
+	QMetaObject::invokeMethod(m_evaluator, "setup", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, isSuccess), Q_ARG(QString, script));
 
-	return m_findProxy.isCallable();
+	QMutexLocker locker(&m_mutex);
+
+	m_cache.clear();
+
+	return isSuccess;
 }
 
 }
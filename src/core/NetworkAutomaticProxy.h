@@ -21,6 +21,10 @@
 #ifndef OTTER_NETWORKAUTOMATICPROXY_H
 #define OTTER_NETWORKAUTOMATICPROXY_H
 
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QThread>
+#include <QtNetwork/QHostInfo>
 #include <QtNetwork/QNetworkProxy>
 #include <QtQml/QJSEngine>
 
@@ -34,8 +38,11 @@ class PacUtils final : public QObject
 public:
 	explicit PacUtils(QObject *parent = nullptr);
 
+	static void cacheHost(const QHostInfo &hostInformation);
+	static bool hasHost(const QString &host);
+
 public slots:
-	void alert(const QString &message) const;
+	void alert(const QString &message);
 	QString dnsResolve(const QString &host) const;
 	QString myIpAddress() const;
 	int dnsDomainLevels(const QString &host) const;
@@ -50,33 +57,81 @@ public slots:
 	bool timeRange(const QVariant &arg1, const QVariant &arg2, const QVariant &arg3, const QVariant &arg4, const QVariant &arg5, const QVariant &arg6, const QString &gmt = QLatin1String("gmt")) const;
 
 protected:
+	struct HostInformation final
+	{
+		QList<QHostAddress> addresses;
+		qint64 expirationTime = 0;
+	};
+
 	bool isDateInRange(const QDate &from, const QDate &to, const QDate &value) const;
 	bool isTimeInRange(const QTime &from, const QTime &to, const QTime &value) const;
 	bool isNumberInRange(int from, int to, int value) const;
+	static QList<QHostAddress> resolveHost(const QString &host);
 
 private:
 	static QStringList m_months;
 	static QStringList m_days;
+	static QHash<QString, HostInformation> m_hosts;
+	static QMutex m_hostsMutex;
+
+signals:
+	void alertRequested(const QString &message);
+};
+
+class PacEvaluator final : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit PacEvaluator(QObject *parent = nullptr);
+
+public slots:
+	void prefetchProxy(const QString &key, const QString &url, const QString &host);
+	QString findProxy(const QString &url, const QString &host);
+	bool setup(const QString &script);
+
+private:
+	QJSEngine *m_engine;
+	QJSValue m_findProxy;
+
+signals:
+	void alertRequested(const QString &message);
+	void proxyPrefetched(const QString &key, const QString &configuration);
 };
 
 class NetworkAutomaticProxy final : public QObject
 {
 public:
 	explicit NetworkAutomaticProxy(const QString &path, QObject *parent = nullptr);
+	~NetworkAutomaticProxy();
 
+	void prefetchProxy(const QUrl &url);
 	void setPath(const QString &path);
 	QString getPath() const;
-	QVector<QNetworkProxy> getProxy(const QString &url, const QString &host);
+	QVector<QNetworkProxy> getProxy(const QUrl &url, const QString &host);
 	bool isValid() const;
 
 protected:
+	struct ProxyInformation final
+	{
+		QVector<QNetworkProxy> proxies;
+		qint64 expirationTime = 0;
+	};
+
+	void cacheProxy(const QString &key, const QString &configuration);
+	QString evaluateProxy(const QString &url, const QString &host);
+	QVector<QNetworkProxy> parseProxy(const QString &configuration);
 	bool setup(const QString &script);
+	static QString getCacheKey(const QUrl &url, const QString &host);
 
 private:
-	QJSEngine m_engine;
-	QJSValue m_findProxy;
+	QThread m_thread;
+	PacEvaluator *m_evaluator;
 	QString m_path;
 	QHash<QString, QVector<QNetworkProxy> > m_proxies;
+	QHash<QString, ProxyInformation> m_cache;
+	QSet<QString> m_prefetches;
+	QMutex m_mutex;
 	bool m_isValid;
 };
 
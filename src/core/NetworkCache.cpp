@@ -18,18 +18,46 @@
 **************************************************************************/
 
 #include "NetworkCache.h"
+#include "Application.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
+#include "TasksManager.h"
 
-#include <QtCore/QDateTime>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QMimeDatabase>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimerEvent>
+
+#include <algorithm>
+
+#define INDEX_FILE_MAGIC static_cast<quint32>(0x4F4E4349)
+#define INDEX_FILE_VERSION static_cast<quint32>(2)
+#define CACHE_MAINTENANCE_INTERVAL 30
+#define CACHE_STALE_PERIOD 7
+#define MEMORY_CACHE_ENTRY_LIMIT 262144
 
 namespace Otter
 {
 
-NetworkCache::NetworkCache(QObject *parent) : QNetworkDiskCache(parent)
+NetworkCache::NetworkCache(bool isPrivate, QObject *parent) : QNetworkDiskCache(parent),
+	m_indexWatcher(nullptr),
+	m_maintenanceWatcher(nullptr),
+	m_memoryCacheEntryLimit(0),
+	m_indexSize(0),
+	m_maintenanceTask(0),
+	m_indexSaveTimer(0),
+	m_hasAccessChanges(false),
+	m_isIndexReady(false),
+	m_isPrivate(isPrivate)
 {
-	const QString cachePath(SessionsManager::getCachePath());
+	setMemoryCacheLimit(SettingsManager::getOption(SettingsManager::Cache_MemoryCacheLimitOption).toInt());
+
+	const QString cachePath(isPrivate ? QString() : SessionsManager::getCachePath());
 
 	if (!cachePath.isEmpty())
 	{
@@ -38,15 +66,134 @@ NetworkCache::NetworkCache(QObject *parent) : QNetworkDiskCache(parent)
 		setCacheDirectory(cachePath);
 		setMaximumCacheSize(SettingsManager::getOption(SettingsManager::Cache_DiskCacheLimitOption).toInt() * 1024);
 
-		connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &NetworkCache::handleOptionChanged);
+		const QStringList dataDirectories(QDir(cacheDirectory()).entryList({QLatin1String("data*")}, (QDir::AllDirs | QDir::NoDotAndDotDot), QDir::Name));
+
+		m_dataDirectory = QDir(cacheDirectory()).absoluteFilePath(dataDirectories.isEmpty() ? QLatin1String("data8") : dataDirectories.last());
+
+		loadIndex();
+
+		m_maintenanceTask = TasksManager::registerTask(CACHE_MAINTENANCE_INTERVAL, true, [&]()
+		{
+			runMaintenance();
+		}, this);
+	}
+
+	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &NetworkCache::handleOptionChanged);
+}
+
+NetworkCache::~NetworkCache()
+{
+	if (m_maintenanceTask > 0)
+	{
+		TasksManager::removeTask(m_maintenanceTask);
+	}
+
+	if (m_indexSaveTimer != 0 || m_hasAccessChanges)
+	{
+		saveIndex();
+	}
+}
+
+void NetworkCache::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_indexSaveTimer)
+	{
+		return;
 	}
+
+	killTimer(m_indexSaveTimer);
+
+	m_indexSaveTimer = 0;
+
+	saveIndex();
 }
 
 void NetworkCache::handleOptionChanged(int identifier, const QVariant &value)
 {
-	if (identifier == SettingsManager::Cache_DiskCacheLimitOption)
+	switch (identifier)
+	{
+		case SettingsManager::Cache_DiskCacheLimitOption:
+			if (!m_isPrivate)
+			{
+				setMaximumCacheSize(value.toInt() * 1024);
+			}
+
+			break;
+		case SettingsManager::Cache_MemoryCacheLimitOption:
+			setMemoryCacheLimit(value.toInt());
+
+			break;
+		default:
+			break;
+	}
+}
+
+void NetworkCache::handleIndexCreated()
+{
+	if (!m_indexWatcher)
+	{
+		return;
+	}
+
+	const QHash<QUrl, IndexEntry> index(m_indexWatcher->result());
+	QHash<QUrl, IndexEntry>::const_iterator iterator;
+
+	for (iterator = index.constBegin(); iterator != index.constEnd(); ++iterator)
+	{
+		if (!m_index.contains(iterator.key()) && !m_removedEntries.contains(iterator.key()))
+		{
+			m_index[iterator.key()] = iterator.value();
+
+			m_indexSize += iterator.value().size;
+		}
+	}
+
+	m_indexWatcher->deleteLater();
+	m_indexWatcher = nullptr;
+
+	m_removedEntries.clear();
+
+	m_isIndexReady = true;
+
+	scheduleIndexSave();
+
+	emit indexReady();
+
+	if (m_indexSize > maximumCacheSize())
+	{
+		runMaintenance();
+	}
+}
+
+void NetworkCache::handleMaintenanceFinished()
+{
+	if (!m_maintenanceWatcher)
 	{
-		setMaximumCacheSize(value.toInt() * 1024);
+		return;
+	}
+
+	const QVector<QUrl> removedEntries(m_maintenanceWatcher->result());
+
+	m_maintenanceWatcher->deleteLater();
+	m_maintenanceWatcher = nullptr;
+
+	for (int i = 0; i < removedEntries.count(); ++i)
+	{
+		const QUrl url(removedEntries.at(i));
+
+		m_memoryCache.remove(url);
+
+		if (m_index.contains(url))
+		{
+			m_indexSize -= m_index.take(url).size;
+
+			emit entryRemoved(url);
+		}
+	}
+
+	if (!removedEntries.isEmpty() || m_hasAccessChanges)
+	{
+		scheduleIndexSave();
 	}
 }
 
@@ -62,6 +209,28 @@ void NetworkCache::clearCache(int period)
 	}
 
 	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
+
+	if (m_isIndexReady)
+	{
+		QVector<QUrl> entries;
+		QHash<QUrl, IndexEntry>::const_iterator iterator;
+
+		for (iterator = m_index.constBegin(); iterator != m_index.constEnd(); ++iterator)
+		{
+			if (iterator.value().lastModified.secsTo(currentDateTime) < (period * 3600))
+			{
+				entries.append(iterator.key());
+			}
+		}
+
+		for (int i = 0; i < entries.count(); ++i)
+		{
+			remove(entries.at(i));
+		}
+
+		return;
+	}
+
 	const QDir cacheMainDirectory(cacheDirectory());
 	const QStringList directories(cacheMainDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot));
 
@@ -90,37 +259,415 @@ void NetworkCache::clearCache(int period)
 	}
 }
 
+void NetworkCache::clear()
+{
+	m_memoryCache.clear();
+
+	if (m_isPrivate)
+	{
+		return;
+	}
+
+	QNetworkDiskCache::clear();
+
+	if (m_indexWatcher)
+	{
+		m_indexWatcher->disconnect(this);
+		m_indexWatcher->deleteLater();
+		m_indexWatcher = nullptr;
+	}
+
+	if (m_maintenanceWatcher)
+	{
+		m_maintenanceWatcher->disconnect(this);
+		m_maintenanceWatcher->deleteLater();
+		m_maintenanceWatcher = nullptr;
+	}
+
+	m_index.clear();
+	m_removedEntries.clear();
+
+	m_indexSize = 0;
+
+	m_isIndexReady = !cacheDirectory().isEmpty();
+
+	scheduleIndexSave();
+}
+
 void NetworkCache::insert(QIODevice *device)
 {
+	const bool hasDevice(m_devices.contains(device));
+	const QNetworkCacheMetaData metaData(hasDevice ? m_devices.take(device) : QNetworkCacheMetaData());
+	const qint64 size(device->size());
+
+	if (m_isPrivate)
+	{
+		QBuffer *buffer(qobject_cast<QBuffer*>(device));
+
+		if (hasDevice && buffer && size <= m_memoryCacheEntryLimit)
+		{
+			MemoryEntry *entry(new MemoryEntry());
+			entry->metaData = metaData;
+			entry->data = buffer->data();
+
+			m_memoryCache.insert(metaData.url(), entry, static_cast<int>(size));
+		}
+
+		device->deleteLater();
+
+		return;
+	}
+
+	if (hasDevice)
+	{
+		m_memoryCache.remove(metaData.url());
+	}
+
 	QNetworkDiskCache::insert(device);
 
-	if (m_devices.contains(device))
+	if (hasDevice)
+	{
+		IndexEntry entry;
+		entry.path = getCacheFileName(metaData.url());
+		entry.lastAccessed = QDateTime::currentDateTimeUtc();
+		entry.lastModified = entry.lastAccessed;
+		entry.expirationDate = metaData.expirationDate();
+		entry.size = size;
+
+		if (m_index.contains(metaData.url()))
+		{
+			m_indexSize -= m_index[metaData.url()].size;
+		}
+
+		m_index[metaData.url()] = entry;
+		m_indexSize += size;
+		m_removedEntries.remove(metaData.url());
+
+		scheduleIndexSave();
+
+		emit entryAdded(metaData.url());
+	}
+}
+
+void NetworkCache::updateMetaData(const QNetworkCacheMetaData &metaData)
+{
+	MemoryEntry *entry(m_memoryCache.object(metaData.url()));
+
+	if (entry)
+	{
+		entry->metaData = metaData;
+	}
+
+	if (m_isPrivate)
+	{
+		return;
+	}
+
+	QNetworkDiskCache::updateMetaData(metaData);
+
+	if (m_index.contains(metaData.url()))
+	{
+		m_index[metaData.url()].expirationDate = metaData.expirationDate();
+
+		scheduleIndexSave();
+	}
+}
+
+void NetworkCache::loadIndex()
+{
+	QFile file(getIndexPath());
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		rebuildIndex();
+
+		return;
+	}
+
+	QDataStream stream(&file);
+	quint32 magic;
+	quint32 version;
+	quint32 amount;
+
+	stream >> magic >> version >> amount;
+
+	if (magic != INDEX_FILE_MAGIC || version != INDEX_FILE_VERSION)
+	{
+		rebuildIndex();
+
+		return;
+	}
+
+	m_index.reserve(static_cast<int>(amount));
+
+	for (quint32 i = 0; i < amount; ++i)
+	{
+		QUrl url;
+		IndexEntry entry;
+
+		stream >> url >> entry.path >> entry.lastAccessed >> entry.lastModified >> entry.expirationDate >> entry.size;
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			m_index.clear();
+
+			m_indexSize = 0;
+
+			rebuildIndex();
+
+			return;
+		}
+
+		m_index[url] = entry;
+
+		m_indexSize += entry.size;
+	}
+
+	m_isIndexReady = true;
+}
+
+void NetworkCache::saveIndex()
+{
+	if (!m_isIndexReady || cacheDirectory().isEmpty())
+	{
+		return;
+	}
+
+	QSaveFile file(getIndexPath());
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream << INDEX_FILE_MAGIC << INDEX_FILE_VERSION << static_cast<quint32>(m_index.count());
+
+	QHash<QUrl, IndexEntry>::const_iterator iterator;
+
+	for (iterator = m_index.constBegin(); iterator != m_index.constEnd(); ++iterator)
 	{
-		emit entryAdded(m_devices[device]);
+		stream << iterator.key() << iterator.value().path << iterator.value().lastAccessed << iterator.value().lastModified << iterator.value().expirationDate << iterator.value().size;
+	}
+
+	if (file.commit())
+	{
+		m_hasAccessChanges = false;
+	}
+}
 
-		m_devices.remove(device);
+void NetworkCache::rebuildIndex()
+{
+	if (m_indexWatcher || cacheDirectory().isEmpty())
+	{
+		return;
 	}
+
+	m_isIndexReady = false;
+
+	m_indexWatcher = new QFutureWatcher<QHash<QUrl, IndexEntry> >(this);
+	m_indexWatcher->setFuture(QtConcurrent::run(&NetworkCache::createIndex, m_dataDirectory));
+
+	connect(m_indexWatcher, &QFutureWatcher<QHash<QUrl, IndexEntry> >::finished, this, &NetworkCache::handleIndexCreated);
+}
+
+void NetworkCache::runMaintenance()
+{
+	if (m_isPrivate || !m_isIndexReady || m_maintenanceWatcher || cacheDirectory().isEmpty())
+	{
+		return;
+	}
+
+	QHash<QUrl, IndexEntry>::iterator iterator;
+
+	for (iterator = m_index.begin(); iterator != m_index.end(); ++iterator)
+	{
+		if (iterator.value().path.isEmpty())
+		{
+			iterator.value().path = getCacheFileName(iterator.key());
+		}
+	}
+
+	m_maintenanceWatcher = new QFutureWatcher<QVector<QUrl> >(this);
+	m_maintenanceWatcher->setFuture(QtConcurrent::run(&NetworkCache::performMaintenance, m_index, maximumCacheSize(), QDateTime::currentDateTimeUtc()));
+
+	connect(m_maintenanceWatcher, &QFutureWatcher<QVector<QUrl> >::finished, this, &NetworkCache::handleMaintenanceFinished);
+}
+
+void NetworkCache::setMemoryCacheLimit(int limit)
+{
+	m_memoryCache.setMaxCost(qMax(0, limit) * 1024);
+
+	m_memoryCacheEntryLimit = qMin(static_cast<qint64>(MEMORY_CACHE_ENTRY_LIMIT), static_cast<qint64>(m_memoryCache.maxCost() / 8));
+}
+
+void NetworkCache::scheduleIndexSave()
+{
+	if (cacheDirectory().isEmpty())
+	{
+		return;
+	}
+
+	if (Application::isAboutToQuit())
+	{
+		saveIndex();
+	}
+	else if (m_indexSaveTimer == 0)
+	{
+		m_indexSaveTimer = startTimer(5000);
+	}
+}
+
+QIODevice* NetworkCache::data(const QUrl &url)
+{
+	const MemoryEntry *entry(m_memoryCache.object(url));
+
+	if (m_index.contains(url))
+	{
+		m_index[url].lastAccessed = QDateTime::currentDateTimeUtc();
+
+		m_hasAccessChanges = true;
+	}
+
+	if (entry)
+	{
+		++m_memoryCacheStatistics.hits;
+
+		m_memoryCacheStatistics.bytesServed += entry->data.size();
+
+		QBuffer *buffer(new QBuffer());
+		buffer->setData(entry->data);
+		buffer->open(QIODevice::ReadOnly);
+
+		return buffer;
+	}
+
+	++m_memoryCacheStatistics.misses;
+
+	if (m_isPrivate)
+	{
+		return nullptr;
+	}
+
+	QIODevice *device(QNetworkDiskCache::data(url));
+
+	if (!device || device->size() > m_memoryCacheEntryLimit)
+	{
+		return device;
+	}
+
+	MemoryEntry *newEntry(new MemoryEntry());
+	newEntry->metaData = QNetworkDiskCache::metaData(url);
+	newEntry->data = device->readAll();
+
+	device->deleteLater();
+
+	QBuffer *buffer(new QBuffer());
+	buffer->setData(newEntry->data);
+	buffer->open(QIODevice::ReadOnly);
+
+	if (newEntry->metaData.isValid())
+	{
+		m_memoryCache.insert(url, newEntry, newEntry->data.size());
+	}
+	else
+	{
+		delete newEntry;
+	}
+
+	return buffer;
 }
 
 QIODevice* NetworkCache::prepare(const QNetworkCacheMetaData &metaData)
 {
+	if (m_isPrivate)
+	{
+		if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk() || m_memoryCacheEntryLimit <= 0)
+		{
+			return nullptr;
+		}
+
+		const QNetworkCacheMetaData::RawHeaderList headers(metaData.rawHeaders());
+
+		for (int i = 0; i < headers.count(); ++i)
+		{
+			if (headers.at(i).first.toLower() == QByteArrayLiteral("content-length") && headers.at(i).second.toLongLong() > m_memoryCacheEntryLimit)
+			{
+				return nullptr;
+			}
+		}
+
+		QBuffer *buffer(new QBuffer());
+		buffer->open(QIODevice::ReadWrite);
+
+		m_devices[buffer] = metaData;
+
+		return buffer;
+	}
+
 	QIODevice *device(QNetworkDiskCache::prepare(metaData));
 
 	if (device)
 	{
-		m_devices[device] = metaData.url();
+		m_devices[device] = metaData;
 	}
 
 	return device;
 }
 
+QNetworkCacheMetaData NetworkCache::metaData(const QUrl &url)
+{
+	const MemoryEntry *entry(m_memoryCache.object(url));
+
+	if (entry)
+	{
+		return entry->metaData;
+	}
+
+	return (m_isPrivate ? QNetworkCacheMetaData() : QNetworkDiskCache::metaData(url));
+}
+
 QString NetworkCache::getPathForUrl(const QUrl &url)
 {
-	if (!url.isValid() || !metaData(url).isValid())
+	if (m_isPrivate || !url.isValid())
+	{
+		return {};
+	}
+
+	if (m_isIndexReady)
+	{
+		if (!m_index.contains(url))
+		{
+			return {};
+		}
+
+		const QString path(m_index[url].path);
+
+		if (!path.isEmpty() && QFile::exists(path))
+		{
+			return path;
+		}
+	}
+
+	if (!metaData(url).isValid())
 	{
 		return {};
 	}
 
+	const QString candidatePath(getCacheFileName(url));
+
+	if (readMetaData(candidatePath).url() == url)
+	{
+		if (m_index.contains(url))
+		{
+			m_index[url].path = candidatePath;
+
+			scheduleIndexSave();
+		}
+
+		return candidatePath;
+	}
+
 	const QDir cacheMainDirectory(cacheDirectory());
 	const QStringList directories(cacheMainDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot));
 
@@ -141,6 +688,13 @@ QString NetworkCache::getPathForUrl(const QUrl &url)
 
 				if (metaData.isValid() && url == metaData.url())
 				{
+					if (m_index.contains(url))
+					{
+						m_index[url].path = cacheFilePath;
+
+						scheduleIndexSave();
+					}
+
 					return cacheFilePath;
 				}
 			}
@@ -150,8 +704,30 @@ QString NetworkCache::getPathForUrl(const QUrl &url)
 	return {};
 }
 
+QString NetworkCache::getCacheFileName(const QUrl &url) const
+{
+	QUrl cleanUrl(url);
+	cleanUrl.setPassword({});
+	cleanUrl.setFragment({});
+
+	const QByteArray hash(QCryptographicHash::hash(cleanUrl.toEncoded(), QCryptographicHash::Sha1));
+	const QByteArray identifier(QByteArray::number(*reinterpret_cast<const qlonglong*>(hash.constData()), 36).left(8));
+
+	return QDir(m_dataDirectory).absoluteFilePath(QString::number((static_cast<uint>(identifier.at(identifier.length() - 1)) % 16), 16) + QLatin1Char('/') + QString::fromLatin1(identifier) + QLatin1String(".d"));
+}
+
+QString NetworkCache::getIndexPath() const
+{
+	return QDir(cacheDirectory()).absoluteFilePath(QLatin1String("index.dat"));
+}
+
 QVector<QUrl> NetworkCache::getEntries() const
 {
+	if (m_isIndexReady)
+	{
+		return m_index.keys().toVector();
+	}
+
 	QVector<QUrl> entries;
 	const QDir cacheMainDirectory(cacheDirectory());
 	const QStringList directories(cacheMainDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot));
@@ -185,10 +761,253 @@ QVector<QUrl> NetworkCache::getEntries() const
 	return entries;
 }
 
+QVector<QPair<QUrl, NetworkCache::IndexEntry> > NetworkCache::getIndex() const
+{
+	QVector<QPair<QUrl, IndexEntry> > entries;
+	entries.reserve(m_index.count());
+
+	QHash<QUrl, IndexEntry>::const_iterator iterator;
+
+	for (iterator = m_index.constBegin(); iterator != m_index.constEnd(); ++iterator)
+	{
+		IndexEntry entry(iterator.value());
+
+		if (entry.path.isEmpty())
+		{
+			entry.path = getCacheFileName(iterator.key());
+		}
+
+		entries.append({iterator.key(), entry});
+	}
+
+	return entries;
+}
+
+NetworkCache::MemoryCacheStatistics NetworkCache::getMemoryCacheStatistics() const
+{
+	MemoryCacheStatistics statistics(m_memoryCacheStatistics);
+	statistics.bytesStored = m_memoryCache.totalCost();
+	statistics.entries = m_memoryCache.count();
+
+	return statistics;
+}
+
+QHash<QUrl, NetworkCache::IndexEntry> NetworkCache::createIndex(const QString &directory)
+{
+	QHash<QUrl, IndexEntry> index;
+	QDirIterator iterator(directory, {QLatin1String("*.d")}, QDir::Files, QDirIterator::Subdirectories);
+
+	while (iterator.hasNext())
+	{
+		const QString path(iterator.next());
+		const QNetworkCacheMetaData metaData(readMetaData(path));
+
+		if (metaData.url().isValid())
+		{
+			const QFileInfo information(iterator.fileInfo());
+			IndexEntry entry;
+			entry.path = path;
+			entry.lastModified = information.lastModified().toUTC();
+			entry.lastAccessed = entry.lastModified;
+			entry.expirationDate = metaData.expirationDate();
+			entry.size = information.size();
+
+			index[metaData.url()] = entry;
+		}
+	}
+
+	return index;
+}
+
+QHash<QString, QVector<NetworkCache::EntryInformation> > NetworkCache::readEntriesInformation(const QVector<QPair<QUrl, IndexEntry> > &entries)
+{
+	const QMimeDatabase mimeDatabase;
+	QHash<QString, QVector<EntryInformation> > information;
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		const QUrl url(entries.at(i).first);
+		const QNetworkCacheMetaData metaData(readMetaData(entries.at(i).second.path));
+		const QNetworkCacheMetaData::RawHeaderList headers(metaData.rawHeaders());
+		QMimeType mimeType;
+
+		for (int j = 0; j < headers.count(); ++j)
+		{
+			if (headers.at(j).first.toLower() == QByteArrayLiteral("content-type"))
+			{
+				mimeType = mimeDatabase.mimeTypeForName(QString::fromLatin1(headers.at(j).second).section(QLatin1Char(';'), 0, 0).trimmed());
+
+				break;
+			}
+		}
+
+		EntryInformation entry;
+		entry.url = url;
+		entry.mimeType = (mimeType.isValid() ? mimeType : mimeDatabase.mimeTypeForUrl(url)).name();
+		entry.lastModified = metaData.lastModified();
+		entry.expirationDate = (metaData.isValid() ? metaData.expirationDate() : entries.at(i).second.expirationDate);
+		entry.size = entries.at(i).second.size;
+
+		information[url.host()].append(entry);
+	}
+
+	return information;
+}
+
+QVector<QUrl> NetworkCache::performMaintenance(const QHash<QUrl, IndexEntry> &index, qint64 maximumSize, const QDateTime &startDateTime)
+{
+	QVector<QUrl> removedEntries;
+	QVector<QPair<QUrl, IndexEntry> > entries;
+	entries.reserve(index.count());
+
+	qint64 totalSize(0);
+	QHash<QUrl, IndexEntry>::const_iterator iterator;
+
+	for (iterator = index.constBegin(); iterator != index.constEnd(); ++iterator)
+	{
+		entries.append({iterator.key(), iterator.value()});
+
+		totalSize += iterator.value().size;
+	}
+
+	std::sort(entries.begin(), entries.end(), [&](const QPair<QUrl, IndexEntry> &first, const QPair<QUrl, IndexEntry> &second)
+	{
+		return (first.second.lastAccessed < second.second.lastAccessed);
+	});
+
+	const QDateTime staleDateTime(startDateTime.addDays(-CACHE_STALE_PERIOD));
+	const qint64 targetSize((maximumSize / 10) * 9);
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		const IndexEntry &entry(entries.at(i).second);
+		const bool isStale(entry.expirationDate.isValid() && entry.expirationDate < startDateTime && entry.lastAccessed < staleDateTime);
+
+		if (!isStale && totalSize <= targetSize)
+		{
+			continue;
+		}
+
+		const QFileInfo information(entry.path);
+
+		if (!information.exists())
+		{
+			removedEntries.append(entries.at(i).first);
+
+			totalSize -= entry.size;
+
+			continue;
+		}
+
+		if (information.lastModified().toUTC() > startDateTime)
+		{
+			continue;
+		}
+
+		if (QFile::remove(entry.path))
+		{
+			removedEntries.append(entries.at(i).first);
+
+			totalSize -= entry.size;
+		}
+	}
+
+	return removedEntries;
+}
+
+QNetworkCacheMetaData NetworkCache::readMetaData(const QString &path)
+{
+	QFile file(path);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return {};
+	}
+
+	QDataStream stream(&file);
+	qint32 magic;
+	qint32 version;
+	qint32 streamVersion;
+
+	stream >> magic >> version >> streamVersion;
+
+	if (magic != 0xe8 || version != 8 || streamVersion > stream.version())
+	{
+		return {};
+	}
+
+	stream.setVersion(streamVersion);
+
+	QNetworkCacheMetaData metaData;
+
+	stream >> metaData;
+
+	return ((stream.status() == QDataStream::Ok) ? metaData : QNetworkCacheMetaData());
+}
+
+qint64 NetworkCache::cacheSize() const
+{
+	if (m_isPrivate)
+	{
+		return m_memoryCache.totalCost();
+	}
+
+	return (m_isIndexReady ? m_indexSize : QNetworkDiskCache::cacheSize());
+}
+
+qint64 NetworkCache::expire()
+{
+	if (!m_isIndexReady || maximumCacheSize() <= 0)
+	{
+		return QNetworkDiskCache::expire();
+	}
+
+	if (m_indexSize > maximumCacheSize())
+	{
+		runMaintenance();
+	}
+
+	return m_indexSize;
+}
+
 bool NetworkCache::remove(const QUrl &url)
 {
+	const bool isInMemory(m_memoryCache.remove(url));
+
+	if (m_isPrivate)
+	{
+		QHash<QIODevice*, QNetworkCacheMetaData>::iterator iterator(m_devices.begin());
+
+		while (iterator != m_devices.end())
+		{
+			if (iterator.value().url() == url)
+			{
+				iterator.key()->deleteLater();
+				iterator = m_devices.erase(iterator);
+			}
+			else
+			{
+				++iterator;
+			}
+		}
+
+		return isInMemory;
+	}
+
 	const bool result(QNetworkDiskCache::remove(url));
 
+	if (m_indexWatcher)
+	{
+		m_removedEntries.insert(url);
+	}
+
+	if (m_index.contains(url))
+	{
+		m_indexSize -= m_index.take(url).size;
+
+		scheduleIndexSave();
+	}
+
 	if (result)
 	{
 		emit entryRemoved(url);
@@ -197,4 +1016,14 @@ bool NetworkCache::remove(const QUrl &url)
 	return result;
 }
 
+bool NetworkCache::isIndexReady() const
+{
+	return m_isIndexReady;
+}
+
+bool NetworkCache::isPrivate() const
+{
+	return m_isPrivate;
+}
+
 }
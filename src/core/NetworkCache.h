@@ -20,6 +20,10 @@
 #ifndef OTTER_NETWORKCACHE_H
 #define OTTER_NETWORKCACHE_H
 
+#include <QtCore/QCache>
+#include <QtCore/QDateTime>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QSet>
 #include <QtNetwork/QNetworkDiskCache>
 
 namespace Otter
@@ -30,25 +34,103 @@ class NetworkCache final : public QNetworkDiskCache
 	Q_OBJECT
 
 public:
-	explicit NetworkCache(QObject *parent = nullptr);
+	struct IndexEntry final
+	{
+		QString path;
+		QDateTime lastAccessed;
+		QDateTime lastModified;
+		QDateTime expirationDate;
+		qint64 size = 0;
+	};
+
+	struct EntryInformation final
+	{
+		QUrl url;
+		QString mimeType;
+		QDateTime lastModified;
+		QDateTime expirationDate;
+		qint64 size = 0;
+	};
+
+	struct MemoryCacheStatistics final
+	{
+		qint64 bytesServed = 0;
+		qint64 bytesStored = 0;
+		quint64 hits = 0;
+		quint64 misses = 0;
+		int entries = 0;
+	};
+
+	explicit NetworkCache(bool isPrivate = false, QObject *parent = nullptr);
+	~NetworkCache();
 
 	void clearCache(int period = 0);
 	void insert(QIODevice *device) override;
+	void updateMetaData(const QNetworkCacheMetaData &metaData) override;
+	QIODevice* data(const QUrl &url) override;
 	QIODevice* prepare(const QNetworkCacheMetaData &metaData) override;
+	QNetworkCacheMetaData metaData(const QUrl &url) override;
 	QString getPathForUrl(const QUrl &url);
 	QVector<QUrl> getEntries() const;
+	QVector<QPair<QUrl, IndexEntry> > getIndex() const;
+	MemoryCacheStatistics getMemoryCacheStatistics() const;
+	qint64 cacheSize() const override;
 	bool remove(const QUrl &url) override;
+	bool isIndexReady() const;
+	bool isPrivate() const;
+	static QHash<QString, QVector<EntryInformation> > readEntriesInformation(const QVector<QPair<QUrl, IndexEntry> > &entries);
+
+public slots:
+	void clear() override;
+	void runMaintenance();
+
+protected:
+	void timerEvent(QTimerEvent *event) override;
+	void loadIndex();
+	void saveIndex();
+	void rebuildIndex();
+	void scheduleIndexSave();
+	QString getCacheFileName(const QUrl &url) const;
+	void setMemoryCacheLimit(int limit);
+	QString getIndexPath() const;
+	qint64 expire() override;
+	static QHash<QUrl, IndexEntry> createIndex(const QString &directory);
+	static QVector<QUrl> performMaintenance(const QHash<QUrl, IndexEntry> &index, qint64 maximumSize, const QDateTime &startDateTime);
+	static QNetworkCacheMetaData readMetaData(const QString &path);
 
 protected slots:
+	void handleIndexCreated();
+	void handleMaintenanceFinished();
 	void handleOptionChanged(int identifier, const QVariant &value);
 
 private:
-	QHash<QIODevice*, QUrl> m_devices;
+	struct MemoryEntry final
+	{
+		QNetworkCacheMetaData metaData;
+		QByteArray data;
+	};
+
+	QFutureWatcher<QHash<QUrl, IndexEntry> > *m_indexWatcher;
+	QFutureWatcher<QVector<QUrl> > *m_maintenanceWatcher;
+	QString m_dataDirectory;
+	QHash<QUrl, IndexEntry> m_index;
+	QHash<QIODevice*, QNetworkCacheMetaData> m_devices;
+	QSet<QUrl> m_removedEntries;
+	QCache<QUrl, MemoryEntry> m_memoryCache;
+	MemoryCacheStatistics m_memoryCacheStatistics;
+	qint64 m_memoryCacheEntryLimit;
+	qint64 m_indexSize;
+	quint64 m_maintenanceTask;
+	int m_indexSaveTimer;
+	bool m_hasAccessChanges;
+	bool m_isIndexReady;
+	bool m_isPrivate;
 
 signals:
 	void cleared();
 	void entryAdded(const QUrl &url);
 	void entryRemoved(const QUrl &url);
+	void indexReady();
 };
 
 }
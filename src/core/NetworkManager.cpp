@@ -31,6 +31,10 @@
 #include "../ui/MainWindow.h"
 
 #include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QUrlQuery>
 #include <QtWidgets/QMessageBox>
 #include <QtNetwork/QNetworkProxy>
 
@@ -61,6 +65,7 @@ NetworkManager::NetworkManager(bool isPrivate, QObject *parent) : QNetworkAccess
 		m_cookieJar = new CookieJar({}, this);
 
 		setCookieJar(m_cookieJar);
+		setCache(new NetworkCache(true, this));
 	}
 
 	connect(this, &NetworkManager::authenticationRequired, this, &NetworkManager::handleAuthenticationRequired);
@@ -146,6 +151,8 @@ QNetworkReply* NetworkManager::createRequest(QNetworkAccessManager::Operation op
 		return new LocalListingNetworkReply(request, this);
 	}
 
+	NetworkManagerFactory::notifyRequestStarted(request.url(), this);
+
 	QNetworkRequest mutableRequest(request);
 
 	if (!NetworkManagerFactory::canSendReferrer())
@@ -172,6 +179,54 @@ QNetworkReply* NetworkManager::createRequest(QNetworkAccessManager::Operation op
 	return QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
 }
 
+QByteArray NetworkManager::createHar(const QVector<RequestTiming> &timings, const QString &title)
+{
+	const QString pageIdentifier(QLatin1String("page_1"));
+	qint64 pageStartTime(-1);
+	QJsonArray entriesArray;
+
+	for (int i = 0; i < timings.count(); ++i)
+	{
+		const RequestTiming &timing(timings.at(i));
+		const qint64 startedTime((timing.startedTime < 0) ? timing.queuedTime : timing.startedTime);
+		const qint64 responseTime((timing.responseTime < 0) ? timing.finishedTime : timing.responseTime);
+		const qint64 blockedDuration(qMax(qint64(0), (startedTime - timing.queuedTime)));
+		const qint64 waitDuration((responseTime < 0) ? 0 : qMax(qint64(0), (responseTime - startedTime)));
+		const qint64 receiveDuration((responseTime < 0 || timing.finishedTime < 0) ? 0 : qMax(qint64(0), (timing.finishedTime - responseTime)));
+
+		if (pageStartTime < 0 || timing.queuedTime < pageStartTime)
+		{
+			pageStartTime = timing.queuedTime;
+		}
+
+		QJsonArray queryArray;
+		const QList<QPair<QString, QString> > queryItems(QUrlQuery(timing.url).queryItems(QUrl::FullyDecoded));
+
+		for (int j = 0; j < queryItems.count(); ++j)
+		{
+			queryArray.append(QJsonObject({{QLatin1String("name"), queryItems.at(j).first}, {QLatin1String("value"), queryItems.at(j).second}}));
+		}
+
+		QJsonObject entryObject({{QLatin1String("pageref"), pageIdentifier}, {QLatin1String("startedDateTime"), QDateTime::fromMSecsSinceEpoch(timing.queuedTime).toUTC().toString(QLatin1String("yyyy-MM-dd'T'HH:mm:ss.zzz'Z'"))}, {QLatin1String("time"), (blockedDuration + waitDuration + receiveDuration)}, {QLatin1String("cache"), QJsonObject()}});
+		entryObject.insert(QLatin1String("request"), QJsonObject({{QLatin1String("method"), timing.method}, {QLatin1String("url"), timing.url.toString()}, {QLatin1String("httpVersion"), QLatin1String("HTTP/1.1")}, {QLatin1String("cookies"), QJsonArray()}, {QLatin1String("headers"), QJsonArray()}, {QLatin1String("queryString"), queryArray}, {QLatin1String("headersSize"), -1}, {QLatin1String("bodySize"), -1}}));
+		entryObject.insert(QLatin1String("response"), QJsonObject({{QLatin1String("status"), timing.statusCode}, {QLatin1String("statusText"), QString()}, {QLatin1String("httpVersion"), QLatin1String("HTTP/1.1")}, {QLatin1String("cookies"), QJsonArray()}, {QLatin1String("headers"), QJsonArray()}, {QLatin1String("content"), QJsonObject({{QLatin1String("size"), timing.bytesReceived}, {QLatin1String("mimeType"), timing.mimeType}})}, {QLatin1String("redirectURL"), QString()}, {QLatin1String("headersSize"), -1}, {QLatin1String("bodySize"), (timing.isCached ? 0 : timing.bytesReceived)}}));
+		entryObject.insert(QLatin1String("timings"), QJsonObject({{QLatin1String("blocked"), blockedDuration}, {QLatin1String("dns"), -1}, {QLatin1String("connect"), -1}, {QLatin1String("ssl"), -1}, {QLatin1String("send"), 0}, {QLatin1String("wait"), waitDuration}, {QLatin1String("receive"), receiveDuration}}));
+
+		if (timing.isBlocked)
+		{
+			entryObject.insert(QLatin1String("_blockedByRule"), timing.rule);
+		}
+
+		entriesArray.append(entryObject);
+	}
+
+	const QJsonObject pageObject({{QLatin1String("id"), pageIdentifier}, {QLatin1String("title"), title}, {QLatin1String("startedDateTime"), QDateTime::fromMSecsSinceEpoch(qMax(pageStartTime, qint64(0))).toUTC().toString(QLatin1String("yyyy-MM-dd'T'HH:mm:ss.zzz'Z'"))}, {QLatin1String("pageTimings"), QJsonObject()}});
+	const QJsonObject creatorObject({{QLatin1String("name"), QLatin1String("Otter Browser")}, {QLatin1String("version"), Application::getFullVersion()}});
+	const QJsonObject logObject({{QLatin1String("version"), QLatin1String("1.2")}, {QLatin1String("creator"), creatorObject}, {QLatin1String("pages"), QJsonArray({pageObject})}, {QLatin1String("entries"), entriesArray}});
+
+	return QJsonDocument(QJsonObject({{QLatin1String("log"), logObject}})).toJson();
+}
+
 NetworkManager::ResourceType NetworkManager::getResourceType(const QNetworkRequest &request, const QUrl &firstPartyUrl)
 {
 	if (request.url() == firstPartyUrl)
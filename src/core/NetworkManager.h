@@ -65,9 +65,29 @@ public:
 		ResourceType resourceType = OtherType;
 	};
 
+	struct RequestTiming final
+	{
+		QUrl url;
+		QString method;
+		QString mimeType;
+		QString rule;
+		qint64 queuedTime = -1;
+		qint64 startedTime = -1;
+		qint64 responseTime = -1;
+		qint64 finishedTime = -1;
+		qint64 bytesReceived = 0;
+		quint64 identifier = 0;
+		int statusCode = 0;
+		ResourceType resourceType = OtherType;
+		bool isBlocked = false;
+		bool isCached = false;
+		bool isEncrypted = false;
+	};
+
 	explicit NetworkManager(bool isPrivate = false, QObject *parent = nullptr);
 
 	CookieJar* getCookieJar() const;
+	static QByteArray createHar(const QVector<RequestTiming> &timings, const QString &title);
 	static ResourceType getResourceType(const QNetworkRequest &request, const QUrl &firstPartyUrl = {});
 
 protected:
@@ -23,6 +23,7 @@
 #include "Application.h"
 #include "ContentFiltersManager.h"
 #include "CookieJar.h"
+#include "HistoryManager.h"
 #include "NetworkCache.h"
 #include "NetworkManager.h"
 #include "NetworkProxyFactory.h"
@@ -30,14 +31,20 @@
 #include "SettingsManager.h"
 #include "WebBackend.h"
 
+#include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtNetwork/QHostInfo>
 #include <QtNetwork/QNetworkConfigurationManager>
 #include <QtNetwork/QSslConfiguration>
 
+#define PRECONNECT_INTERVAL 10000
+#define PRECONNECT_LIFETIME 30000
+#define PRECONNECT_MINIMUM_ATTEMPTS 5
+
 namespace Otter
 {
 
@@ -50,6 +57,8 @@ CookieJar* NetworkManagerFactory::m_cookieJar(nullptr);
 QString NetworkManagerFactory::m_acceptLanguage;
 QMap<QString, ProxyDefinition> NetworkManagerFactory::m_proxies;
 QMap<QString, UserAgentDefinition> NetworkManagerFactory::m_userAgents;
+QHash<QString, NetworkManagerFactory::PreconnectInformation> NetworkManagerFactory::m_preconnects;
+NetworkManagerFactory::PreconnectStatistics NetworkManagerFactory::m_preconnectStatistics;
 NetworkManagerFactory::DoNotTrackPolicy NetworkManagerFactory::m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy);
 QList<QSslCipher> NetworkManagerFactory::m_defaultCiphers;
 bool NetworkManagerFactory::m_canSendReferrer(true);
@@ -572,6 +581,115 @@ void NetworkManagerFactory::notifyAuthenticated(QAuthenticator *authenticator, b
 	emit m_instance->authenticated(authenticator, wasAccepted);
 }
 
+void NetworkManagerFactory::notifyRequestStarted(const QUrl &url, QNetworkAccessManager *manager)
+{
+	if (m_preconnects.isEmpty())
+	{
+		return;
+	}
+
+	const QString key(getPreconnectKey(url));
+
+	if (!m_preconnects.contains(key))
+	{
+		return;
+	}
+
+	PreconnectInformation &information(m_preconnects[key]);
+
+	expirePreconnect(&information, QDateTime::currentMSecsSinceEpoch());
+
+	if (information.isPending && (!information.isConnection || information.manager == manager))
+	{
+		information.isPending = false;
+
+		++information.hits;
+		++m_preconnectStatistics.usedPreconnects;
+	}
+}
+
+void NetworkManagerFactory::preconnect(const QUrl &url, QNetworkAccessManager *manager)
+{
+	const bool isSecure(url.scheme() == QLatin1String("https"));
+
+	if (m_isWorkingOffline || !url.isValid() || url.host().isEmpty() || (!isSecure && url.scheme() != QLatin1String("http")))
+	{
+		return;
+	}
+
+	++m_preconnectStatistics.requests;
+
+	if (m_proxyFactory)
+	{
+		m_proxyFactory->prefetchProxy(url);
+	}
+
+	const quint16 port(static_cast<quint16>(url.port(isSecure ? 443 : 80)));
+	const qint64 currentTime(QDateTime::currentMSecsSinceEpoch());
+	PreconnectInformation &information(m_preconnects[getPreconnectKey(url)]);
+
+	expirePreconnect(&information, currentTime);
+
+	if ((currentTime - information.time) < PRECONNECT_INTERVAL)
+	{
+		++m_preconnectStatistics.throttledRequests;
+
+		return;
+	}
+
+	const bool needsConnection((information.attempts >= PRECONNECT_MINIMUM_ATTEMPTS) ? ((information.hits * 5) >= information.attempts) : HistoryManager::getLastVisitTime(url).isValid());
+
+	information.time = currentTime;
+	information.isConnection = needsConnection;
+	information.isPending = true;
+
+	++information.attempts;
+
+	if (needsConnection)
+	{
+		if (!manager)
+		{
+			manager = getNetworkManager();
+		}
+
+		information.manager = manager;
+
+		++m_preconnectStatistics.connections;
+
+		if (isSecure)
+		{
+			manager->connectToHostEncrypted(url.host(), port);
+		}
+		else
+		{
+			manager->connectToHost(url.host(), port);
+		}
+	}
+	else
+	{
+		information.manager.clear();
+
+		++m_preconnectStatistics.hostLookups;
+
+#if QT_VERSION >= 0x050900
+		QHostInfo::lookupHost(url.host(), m_instance, [](const QHostInfo &hostInformation)
+		{
+			Q_UNUSED(hostInformation)
+		});
+#endif
+	}
+}
+
+void NetworkManagerFactory::expirePreconnect(PreconnectInformation *information, qint64 currentTime)
+{
+	if (information->isPending && (currentTime - information->time) > PRECONNECT_LIFETIME)
+	{
+		information->isPending = false;
+
+		++m_preconnectStatistics.wastedPreconnects;
+	}
+}
+
 void NetworkManagerFactory::updateProxiesOption()
 {
 	SettingsManager::OptionDefinition proxiesOption(SettingsManager::getOptionDefinition(SettingsManager::Network_ProxyOption));
@@ -611,6 +729,11 @@ void NetworkManagerFactory::updateUserAgentsOption()
 	SettingsManager::updateOptionDefinition(SettingsManager::Network_UserAgentOption, userAgentsOption);
 }
 
+QString NetworkManagerFactory::getPreconnectKey(const QUrl &url)
+{
+	return url.scheme() + QLatin1String("://") + url.host() + QLatin1Char(':') + QString::number(url.port((url.scheme() == QLatin1String("https")) ? 443 : 80));
+}
+
 NetworkManagerFactory* NetworkManagerFactory::getInstance()
 {
 	return m_instance;
@@ -634,7 +757,7 @@ NetworkCache* NetworkManagerFactory::getCache()
 {
 	if (!m_cache)
 	{
-		m_cache = new NetworkCache(QCoreApplication::instance());
+		m_cache = new NetworkCache(false, QCoreApplication::instance());
 	}
 
 	return m_cache;
@@ -744,6 +867,19 @@ UserAgentDefinition NetworkManagerFactory::getUserAgent(const QString &identifie
 	return m_userAgents[identifier];
 }
 
+NetworkManagerFactory::PreconnectStatistics NetworkManagerFactory::getPreconnectStatistics()
+{
+	const qint64 currentTime(QDateTime::currentMSecsSinceEpoch());
+	QHash<QString, PreconnectInformation>::iterator iterator;
+
+	for (iterator = m_preconnects.begin(); iterator != m_preconnects.end(); ++iterator)
+	{
+		expirePreconnect(&iterator.value(), currentTime);
+	}
+
+	return m_preconnectStatistics;
+}
+
 NetworkManagerFactory::DoNotTrackPolicy NetworkManagerFactory::getDoNotTrackPolicy()
 {
 	return m_doNotTrackPolicy;
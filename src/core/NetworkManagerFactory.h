@@ -24,6 +24,7 @@
 #include "ItemModel.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QPointer>
 #include <QtNetwork/QAuthenticator>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QSslCipher>
@@ -186,6 +187,16 @@ public:
 
 	Q_ENUM(DoNotTrackPolicy)
 
+	struct PreconnectStatistics final
+	{
+		quint64 requests = 0;
+		quint64 throttledRequests = 0;
+		quint64 hostLookups = 0;
+		quint64 connections = 0;
+		quint64 usedPreconnects = 0;
+		quint64 wastedPreconnects = 0;
+	};
+
 	static void createInstance();
 	static void initialize();
 	static void clearCookies(int period = 0);
@@ -193,6 +204,8 @@ public:
 	static void loadProxies();
 	static void loadUserAgents();
 	static void notifyAuthenticated(QAuthenticator *authenticator, bool wasAccepted);
+	static void notifyRequestStarted(const QUrl &url, QNetworkAccessManager *manager);
+	static void preconnect(const QUrl &url, QNetworkAccessManager *manager = nullptr);
 	static NetworkManagerFactory* getInstance();
 	static NetworkManager* getNetworkManager(bool isPrivate = false);
 	static NetworkCache* getCache();
@@ -205,6 +218,7 @@ public:
 	static QList<QSslCipher> getDefaultCiphers();
 	static ProxyDefinition getProxy(const QString &identifier);
 	static UserAgentDefinition getUserAgent(const QString &identifier);
+	static PreconnectStatistics getPreconnectStatistics();
 	static DoNotTrackPolicy getDoNotTrackPolicy();
 	static bool canSendReferrer();
 	static bool isWorkingOffline();
@@ -212,12 +226,24 @@ public:
 	bool event(QEvent *event) override;
 
 protected:
+	struct PreconnectInformation final
+	{
+		QPointer<QNetworkAccessManager> manager;
+		qint64 time = 0;
+		int attempts = 0;
+		int hits = 0;
+		bool isConnection = false;
+		bool isPending = false;
+	};
+
 	explicit NetworkManagerFactory(QObject *parent = nullptr);
 
+	static void expirePreconnect(PreconnectInformation *information, qint64 currentTime);
 	static void readProxy(const QJsonValue &value, ProxyDefinition *parent);
 	static void readUserAgent(const QJsonValue &value, UserAgentDefinition *parent);
 	static void updateProxiesOption();
 	static void updateUserAgentsOption();
+	static QString getPreconnectKey(const QUrl &url);
 
 protected slots:
 	void handleOptionChanged(int identifier, const QVariant &value);
@@ -232,7 +258,9 @@ private:
 	static QString m_acceptLanguage;
 	static QMap<QString, ProxyDefinition> m_proxies;
 	static QMap<QString, UserAgentDefinition> m_userAgents;
+	static QHash<QString, PreconnectInformation> m_preconnects;
 	static QList<QSslCipher> m_defaultCiphers;
+	static PreconnectStatistics m_preconnectStatistics;
 	static DoNotTrackPolicy m_doNotTrackPolicy;
 	static bool m_canSendReferrer;
 	static bool m_isInitialized;
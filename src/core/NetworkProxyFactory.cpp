@@ -19,8 +19,15 @@
 **************************************************************************/
 
 #include "NetworkProxyFactory.h"
+#include "Console.h"
 #include "NetworkAutomaticProxy.h"
 
+#include <QtCore/QMutexLocker>
+
+#include <algorithm>
+
+#define PROXY_EXCEPTIONS_CACHE_LIMIT 1000
+
 namespace Otter
 {
 
@@ -35,6 +42,14 @@ NetworkProxyFactory::~NetworkProxyFactory()
 	delete m_automaticProxy;
 }
 
+void NetworkProxyFactory::prefetchProxy(const QUrl &url)
+{
+	if (m_definition.type == ProxyDefinition::AutomaticProxy && m_automaticProxy)
+	{
+		m_automaticProxy->prefetchProxy(url);
+	}
+}
+
 void NetworkProxyFactory::setProxy(const QString &identifier)
 {
 	m_definition = NetworkManagerFactory::getProxy(identifier);
@@ -42,6 +57,8 @@ void NetworkProxyFactory::setProxy(const QString &identifier)
 	m_proxies.clear();
 	m_proxies[-1] = {QNetworkProxy(QNetworkProxy::NoProxy)};
 
+	compileExceptions();
+
 	switch (m_definition.type)
 	{
 		case ProxyDefinition::ManualProxy:
@@ -92,24 +109,9 @@ QList<QNetworkProxy> NetworkProxyFactory::queryProxy(const QNetworkProxyQuery &q
 
 		case ProxyDefinition::ManualProxy:
 			{
-				const QString host(query.peerHostName());
-
-				for (int i = 0; i < m_definition.exceptions.count(); ++i)
+				if (isException(query.peerHostName()))
 				{
-					if (m_definition.exceptions.at(i).contains(QLatin1Char('/')))
-					{
-						const QHostAddress address(host);
-						const QPair<QHostAddress, int> subnet(QHostAddress::parseSubnet(m_definition.exceptions.at(i)));
-
-						if (!address.isNull() && subnet.second != -1 && address.isInSubnet(subnet))
-						{
-							return m_proxies[-1];
-						}
-					}
-					else if (host.contains(m_definition.exceptions.at(i), Qt::CaseInsensitive))
-					{
-						return m_proxies[-1];
-					}
+					return m_proxies[-1];
 				}
 
 				if (m_proxies.contains(ProxyDefinition::SocksProtocol))
@@ -139,7 +141,7 @@ QList<QNetworkProxy> NetworkProxyFactory::queryProxy(const QNetworkProxyQuery &q
 		case ProxyDefinition::AutomaticProxy:
 			if (m_automaticProxy && m_automaticProxy->isValid())
 			{
-				return m_automaticProxy->getProxy(query.url().toString(), query.peerHostName()).toList();
+				return m_automaticProxy->getProxy(query.url(), query.peerHostName()).toList();
 			}
 
 			return QNetworkProxyFactory::systemProxyForQuery(query);
@@ -150,6 +152,167 @@ QList<QNetworkProxy> NetworkProxyFactory::queryProxy(const QNetworkProxyQuery &q
 	return m_proxies[-1];
 }
 
+void NetworkProxyFactory::compileExceptions()
+{
+	QMutexLocker locker(&m_exceptionsMutex);
+
+	m_hostExceptions = {HostExceptionNode()};
+	m_subnetExceptions.clear();
+	m_ipv6SubnetExceptions.clear();
+	m_wildcardExceptions.clear();
+	m_exceptionsCache.clear();
+
+	if (m_definition.type != ProxyDefinition::ManualProxy)
+	{
+		return;
+	}
+
+	QVector<SubnetException> subnets;
+
+	for (int i = 0; i < m_definition.exceptions.count(); ++i)
+	{
+		QString exception(m_definition.exceptions.at(i).trimmed().toLower());
+
+		if (exception.isEmpty())
+		{
+			continue;
+		}
+
+		if (!exception.contains(QLatin1Char('/')) && (exception.endsWith(QLatin1Char('.')) || exception.endsWith(QLatin1String(".*"))))
+		{
+			QString prefix(exception);
+
+			while (prefix.endsWith(QLatin1String(".*")))
+			{
+				prefix.chop(2);
+			}
+
+			if (prefix.endsWith(QLatin1Char('.')))
+			{
+				prefix.chop(1);
+			}
+
+			QStringList octets(prefix.split(QLatin1Char('.')));
+			bool isAddressPrefix(octets.count() < 4);
+
+			for (int j = 0; j < octets.count(); ++j)
+			{
+				bool isValid(false);
+
+				if (octets.at(j).toUInt(&isValid) > 255 || !isValid)
+				{
+					isAddressPrefix = false;
+
+					break;
+				}
+			}
+
+			if (isAddressPrefix)
+			{
+				const int length(octets.count() * 8);
+
+				while (octets.count() < 4)
+				{
+					octets.append(QLatin1String("0"));
+				}
+
+				exception = octets.join(QLatin1Char('.')) + QLatin1Char('/') + QString::number(length);
+			}
+		}
+
+		QPair<QHostAddress, int> subnet(QHostAddress::parseSubnet(exception));
+
+		if (subnet.second == -1 && !exception.contains(QLatin1Char('/')) && !QHostAddress(exception).isNull())
+		{
+			const QHostAddress address(exception);
+
+			subnet = {address, ((address.protocol() == QAbstractSocket::IPv4Protocol) ? 32 : 128)};
+		}
+
+		if (subnet.second != -1)
+		{
+			if (subnet.first.protocol() == QAbstractSocket::IPv4Protocol)
+			{
+				const quint32 mask((subnet.second == 0) ? 0 : (0xFFFFFFFFu << (32 - subnet.second)));
+				SubnetException range;
+				range.first = (subnet.first.toIPv4Address() & mask);
+				range.last = (range.first | ~mask);
+
+				subnets.append(range);
+			}
+			else
+			{
+				m_ipv6SubnetExceptions.append(subnet);
+			}
+
+			continue;
+		}
+
+		if (exception.contains(QLatin1Char('/')))
+		{
+			Console::addMessage(tr("Failed to parse proxy exception: %1").arg(m_definition.exceptions.at(i)), Console::NetworkCategory, Console::WarningLevel);
+
+			continue;
+		}
+
+		if (exception.startsWith(QLatin1String("*.")))
+		{
+			exception.remove(0, 2);
+		}
+		else if (exception.startsWith(QLatin1Char('.')))
+		{
+			exception.remove(0, 1);
+		}
+
+		if (exception.contains(QLatin1Char('*')) || exception.contains(QLatin1Char('?')))
+		{
+			m_wildcardExceptions.append(QRegExp(exception, Qt::CaseInsensitive, QRegExp::Wildcard));
+
+			continue;
+		}
+
+		const QStringList labels(exception.split(QLatin1Char('.'), QString::SkipEmptyParts));
+		int node(0);
+
+		for (int j = (labels.count() - 1); j >= 0; --j)
+		{
+			int child(m_hostExceptions.at(node).children.value(labels.at(j), -1));
+
+			if (child < 0)
+			{
+				child = m_hostExceptions.count();
+
+				m_hostExceptions[node].children[labels.at(j)] = child;
+				m_hostExceptions.append(HostExceptionNode());
+			}
+
+			node = child;
+		}
+
+		if (node > 0)
+		{
+			m_hostExceptions[node].isException = true;
+		}
+	}
+
+	std::sort(subnets.begin(), subnets.end(), [&](const SubnetException &first, const SubnetException &second)
+	{
+		return (first.first < second.first);
+	});
+
+	for (int i = 0; i < subnets.count(); ++i)
+	{
+		if (!m_subnetExceptions.isEmpty() && subnets.at(i).first <= m_subnetExceptions.last().last)
+		{
+			m_subnetExceptions.last().last = qMax(m_subnetExceptions.last().last, subnets.at(i).last);
+		}
+		else
+		{
+			m_subnetExceptions.append(subnets.at(i));
+		}
+	}
+}
+
 QNetworkProxy::ProxyType NetworkProxyFactory::getProxyType(ProxyDefinition::ProtocolType protocol)
 {
 	switch (protocol)
@@ -168,6 +331,80 @@ QNetworkProxy::ProxyType NetworkProxyFactory::getProxyType(ProxyDefinition::Prot
 	return QNetworkProxy::DefaultProxy;
 }
 
+bool NetworkProxyFactory::isException(const QString &host)
+{
+	const QString normalizedHost(host.toLower());
+
+	QMutexLocker locker(&m_exceptionsMutex);
+
+	if (m_exceptionsCache.contains(normalizedHost))
+	{
+		return m_exceptionsCache[normalizedHost];
+	}
+
+	const QHostAddress address(normalizedHost);
+	bool isMatching(false);
+
+	if (address.protocol() == QAbstractSocket::IPv4Protocol)
+	{
+		const quint32 value(address.toIPv4Address());
+		const QVector<SubnetException>::const_iterator iterator(std::upper_bound(m_subnetExceptions.constBegin(), m_subnetExceptions.constEnd(), value, [&](quint32 currentValue, const SubnetException &subnet)
+		{
+			return (currentValue < subnet.first);
+		}));
+
+		isMatching = (iterator != m_subnetExceptions.constBegin() && value <= (iterator - 1)->last);
+	}
+	else if (!address.isNull())
+	{
+		for (int i = 0; i < m_ipv6SubnetExceptions.count(); ++i)
+		{
+			if (address.isInSubnet(m_ipv6SubnetExceptions.at(i)))
+			{
+				isMatching = true;
+
+				break;
+			}
+		}
+	}
+	else
+	{
+		const QStringList labels(normalizedHost.split(QLatin1Char('.'), QString::SkipEmptyParts));
+		int node(0);
+
+		for (int i = (labels.count() - 1); i >= 0; --i)
+		{
+			node = m_hostExceptions.at(node).children.value(labels.at(i), -1);
+
+			if (node < 0)
+			{
+				break;
+			}
+
+			if (m_hostExceptions.at(node).isException)
+			{
+				isMatching = true;
+
+				break;
+			}
+		}
+	}
+
+	for (int i = 0; (!isMatching && i < m_wildcardExceptions.count()); ++i)
+	{
+		isMatching = m_wildcardExceptions[i].exactMatch(normalizedHost);
+	}
+
+	if (m_exceptionsCache.count() >= PROXY_EXCEPTIONS_CACHE_LIMIT)
+	{
+		m_exceptionsCache.clear();
+	}
+
+	m_exceptionsCache[normalizedHost] = isMatching;
+
+	return isMatching;
+}
+
 bool NetworkProxyFactory::usesSystemAuthentication()
 {
 	return m_definition.usesSystemAuthentication;
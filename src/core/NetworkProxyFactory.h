@@ -23,6 +23,9 @@
 
 #include "NetworkManagerFactory.h"
 
+#include <QtCore/QMutex>
+#include <QtCore/QRegExp>
+#include <QtNetwork/QHostAddress>
 #include <QtNetwork/QNetworkProxy>
 
 namespace Otter
@@ -38,17 +41,38 @@ public:
 	explicit NetworkProxyFactory(QObject *parent = nullptr);
 	~NetworkProxyFactory();
 
+	void prefetchProxy(const QUrl &url);
 	void setProxy(const QString &identifier);
 	QList<QNetworkProxy> queryProxy(const QNetworkProxyQuery &query) override;
 	bool usesSystemAuthentication();
 
 protected:
+	struct HostExceptionNode final
+	{
+		QHash<QString, int> children;
+		bool isException = false;
+	};
+
+	struct SubnetException final
+	{
+		quint32 first = 0;
+		quint32 last = 0;
+	};
+
+	void compileExceptions();
 	QNetworkProxy::ProxyType getProxyType(ProxyDefinition::ProtocolType protocol);
+	bool isException(const QString &host);
 
 private:
 	NetworkAutomaticProxy *m_automaticProxy;
 	ProxyDefinition m_definition;
 	QMap<int, QList<QNetworkProxy> > m_proxies;
+	QVector<HostExceptionNode> m_hostExceptions;
+	QVector<SubnetException> m_subnetExceptions;
+	QVector<QPair<QHostAddress, int> > m_ipv6SubnetExceptions;
+	QVector<QRegExp> m_wildcardExceptions;
+	QHash<QString, bool> m_exceptionsCache;
+	QMutex m_exceptionsMutex;
 };
 
 }
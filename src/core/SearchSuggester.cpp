@@ -117,7 +117,14 @@ void SearchSuggester::setQuery(const QString &query)
 
 	const SearchEnginesManager::SearchEngineDefinition searchEngine(SearchEnginesManager::getSearchEngine(m_searchEngine));
 
-	if (!searchEngine.isValid() || searchEngine.suggestionsUrl.url.isEmpty())
+	if (!searchEngine.isValid())
+	{
+		return;
+	}
+
+	NetworkManagerFactory::preconnect(QUrl(searchEngine.resultsUrl.url));
+
+	if (searchEngine.suggestionsUrl.url.isEmpty())
 	{
 		return;
 	}
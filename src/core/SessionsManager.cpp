@@ -25,9 +25,18 @@
 #include "../ui/MainWindow.h"
 #include "../ui/Window.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QDir>
-#include <QtCore/QJsonArray>
-#include <QtCore/QJsonObject>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+
+#define SESSION_CHECKPOINT_INTERVAL 30000
+#define SESSION_JOURNAL_RECORDS_LIMIT 250
+#define SESSION_RESTORATION_CHECK_INTERVAL 1000
+#define SESSION_RESTORATION_MEMORY_THRESHOLD 268435456
+#define SESSION_RESTORATION_START_TIMEOUT 5000
+#define SESSION_RESTORATION_TIMEOUT 30000
+#define SESSION_SAVE_DELAY 1000
 
 namespace Otter
 {
@@ -42,14 +51,30 @@ QString SessionsManager::m_sessionPath;
 QString SessionsManager::m_sessionTitle;
 QString SessionsManager::m_cachePath;
 QString SessionsManager::m_profilePath;
+QStringList SessionsManager::m_excludedOptions;
 QHash<QString, Session::Identity> SessionsManager::m_identities;
+QHash<quint64, QJsonObject> SessionsManager::m_windowObjects;
+QHash<quint64, SessionsManager::JournalHistoryState> SessionsManager::m_journalHistoryStates;
+QSet<quint64> SessionsManager::m_modifiedWindows;
 QVector<Session::MainWindow> SessionsManager::m_closedWindows;
+QVector<QPair<quint64, QByteArray> > SessionsManager::m_journalRecords;
+QVector<quint64> SessionsManager::m_journalMainWindows;
+QVector<QPointer<Window> > SessionsManager::m_restorationQueue;
+QVector<SessionsManager::RestoringWindow> SessionsManager::m_restoringWindows;
+QFile* SessionsManager::m_journalFile(nullptr);
+QFuture<bool> SessionsManager::m_saveFuture;
+qint64 SessionsManager::m_journalGeneration(0);
+quint64 SessionsManager::m_journalSequence(0);
+quint64 SessionsManager::m_checkpointSequence(0);
+bool SessionsManager::m_isCheckpointPending(false);
 bool SessionsManager::m_isDirty(false);
 bool SessionsManager::m_isPrivate(false);
 bool SessionsManager::m_isReadOnly(false);
 
 SessionsManager::SessionsManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+	m_restorationTimer(0),
+	m_saveTimer(0),
+	m_saveInterval(0)
 {
 }
 
@@ -65,9 +90,13 @@ void SessionsManager::timerEvent(QTimerEvent *event)
 
 		if (!m_isPrivate)
 		{
-			saveSession({}, {}, nullptr, false);
+			saveCurrentSession();
 		}
 	}
+	else if (event->timerId() == m_restorationTimer)
+	{
+		processRestorationQueue();
+	}
 }
 
 void SessionsManager::createInstance(const QString &profilePath, const QString &cachePath, bool isPrivate, bool isReadOnly)
@@ -82,55 +111,639 @@ void SessionsManager::createInstance(const QString &profilePath, const QString &
 	}
 }
 
-void SessionsManager::scheduleSave()
+void SessionsManager::scheduleSave(int interval)
+{
+	if (m_isPrivate || (m_saveTimer != 0 && m_saveInterval <= interval))
+	{
+		return;
+	}
+
+	if (m_saveTimer != 0)
+	{
+		killTimer(m_saveTimer);
+	}
+
+	m_saveTimer = startTimer(interval);
+	m_saveInterval = interval;
+}
+
+void SessionsManager::processRestorationQueue()
+{
+	const qint64 currentTime(QDateTime::currentMSecsSinceEpoch());
+
+	for (int i = (m_restoringWindows.count() - 1); i >= 0; --i)
+	{
+		const RestoringWindow &restoringWindow(m_restoringWindows.at(i));
+		const qint64 elapsedTime(currentTime - restoringWindow.startTime);
+
+		if (!restoringWindow.window || elapsedTime > SESSION_RESTORATION_TIMEOUT || (!restoringWindow.hasStarted && elapsedTime > SESSION_RESTORATION_START_TIMEOUT))
+		{
+			if (restoringWindow.window)
+			{
+				disconnect(restoringWindow.window, &Window::loadingStateChanged, this, &SessionsManager::handleRestoringWindowLoadingStateChanged);
+			}
+
+			m_restoringWindows.removeAt(i);
+		}
+	}
+
+	const int limit(qMax(1, SettingsManager::getOption(SettingsManager::Sessions_TabsLoadingLimitAmountOption).toInt()));
+
+	while (m_restoringWindows.count() < limit && !m_restorationQueue.isEmpty())
+	{
+		const qint64 availableMemory(Utils::getAvailableMemory());
+
+		if (availableMemory >= 0 && availableMemory < SESSION_RESTORATION_MEMORY_THRESHOLD)
+		{
+			break;
+		}
+
+		Window *window(m_restorationQueue.takeFirst());
+
+		if (!window || window->isAboutToClose() || window->getLoadingState() != WebWidget::DeferredLoadingState)
+		{
+			continue;
+		}
+
+		window->getContentsWidget();
+
+		if (window->getType() == QLatin1String("web"))
+		{
+			RestoringWindow restoringWindow;
+			restoringWindow.window = window;
+			restoringWindow.startTime = currentTime;
+			restoringWindow.hasStarted = (window->getLoadingState() == WebWidget::OngoingLoadingState);
+
+			m_restoringWindows.append(restoringWindow);
+
+			connect(window, &Window::loadingStateChanged, this, &SessionsManager::handleRestoringWindowLoadingStateChanged);
+		}
+	}
+
+	if (m_restorationQueue.isEmpty() && m_restoringWindows.isEmpty())
+	{
+		if (m_restorationTimer != 0)
+		{
+			killTimer(m_restorationTimer);
+
+			m_restorationTimer = 0;
+		}
+	}
+	else if (m_restorationTimer == 0)
+	{
+		m_restorationTimer = startTimer(SESSION_RESTORATION_CHECK_INTERVAL);
+	}
+}
+
+void SessionsManager::handleRestoringWindowLoadingStateChanged()
+{
+	const Window *window(qobject_cast<Window*>(sender()));
+
+	if (!window)
+	{
+		return;
+	}
+
+	for (int i = 0; i < m_restoringWindows.count(); ++i)
+	{
+		if (m_restoringWindows.at(i).window != window)
+		{
+			continue;
+		}
+
+		if (window->getLoadingState() == WebWidget::OngoingLoadingState)
+		{
+			m_restoringWindows[i].hasStarted = true;
+		}
+		else if (m_restoringWindows.at(i).hasStarted)
+		{
+			disconnect(window, &Window::loadingStateChanged, this, &SessionsManager::handleRestoringWindowLoadingStateChanged);
+
+			m_restoringWindows.removeAt(i);
+
+			processRestorationQueue();
+		}
+
+		break;
+	}
+}
+
+void SessionsManager::clearClosedWindows()
+{
+	m_closedWindows.clear();
+
+	emit m_instance->closedWindowsChanged();
+}
+
+void SessionsManager::storeClosedWindow(MainWindow *mainWindow)
+{
+	if (!mainWindow || mainWindow->isPrivate())
+	{
+		return;
+	}
+
+	const Session::MainWindow session(mainWindow->getSession());
+
+	if (session.windows.isEmpty())
+	{
+		return;
+	}
+
+	const int limit(SettingsManager::getOption(SettingsManager::History_ClosedTabsLimitAmountOption).toInt());
+
+	m_closedWindows.prepend(session);
+
+	if (m_closedWindows.count() > limit)
+	{
+		m_closedWindows.resize(limit);
+		m_closedWindows.squeeze();
+	}
+
+	emit m_instance->closedWindowsChanged();
+}
+
+void SessionsManager::markSessionAsModified()
+{
+	if (!m_isPrivate && m_sessionPath == QLatin1String("default"))
+	{
+		m_isDirty = true;
+
+		m_instance->scheduleSave(SESSION_SAVE_DELAY);
+	}
+}
+
+void SessionsManager::markWindowAsModified(quint64 identifier)
+{
+	m_modifiedWindows.insert(identifier);
+
+	markSessionAsModified();
+}
+
+void SessionsManager::journalWindowOpened(const Window *window)
+{
+	const MainWindow *mainWindow(window->getMainWindow());
+
+	if (window->isPrivate() || !mainWindow || mainWindow->isPrivate())
+	{
+		return;
+	}
+
+	if (!isJournalActive())
+	{
+		markWindowAsModified(window->getIdentifier());
+
+		return;
+	}
+
+	const Session::Window session(window->getSession());
+	JournalHistoryState &state(m_journalHistoryStates[window->getIdentifier()]);
+	state.amount = session.history.entries.count();
+	state.index = session.history.index;
+
+	if (session.history.index >= 0 && session.history.index < session.history.entries.count())
+	{
+		state.url = session.history.entries.at(session.history.index).url;
+		state.title = session.history.entries.at(session.history.index).title;
+	}
+
+	m_modifiedWindows.insert(window->getIdentifier());
+
+	appendJournalRecord({{QLatin1String("type"), QLatin1String("openTab")}, {QLatin1String("mainWindow"), m_journalMainWindows.indexOf(mainWindow->getIdentifier())}, {QLatin1String("index"), getJournalWindowIndex(mainWindow, mainWindow->getWindowIndex(window->getIdentifier()))}, {QLatin1String("window"), createWindowObject(session, m_excludedOptions)}});
+}
+
+void SessionsManager::journalWindowClosed(const Window *window)
 {
-	if (m_saveTimer == 0 && !m_isPrivate)
+	const MainWindow *mainWindow(window->getMainWindow());
+
+	m_journalHistoryStates.remove(window->getIdentifier());
+
+	if (window->isPrivate() || !mainWindow || mainWindow->isPrivate())
 	{
-		m_saveTimer = startTimer(1000);
+		return;
+	}
+
+	if (!isJournalActive())
+	{
+		markSessionAsModified();
+
+		return;
 	}
+
+	appendJournalRecord({{QLatin1String("type"), QLatin1String("closeTab")}, {QLatin1String("mainWindow"), m_journalMainWindows.indexOf(mainWindow->getIdentifier())}, {QLatin1String("index"), getJournalWindowIndex(mainWindow, mainWindow->getWindowIndex(window->getIdentifier()))}});
 }
 
-void SessionsManager::clearClosedWindows()
-{
-	m_closedWindows.clear();
+void SessionsManager::journalWindowMoved(const MainWindow *mainWindow, int from, int to)
+{
+	const Window *window(mainWindow->getWindowByIndex(to));
+
+	if (!window || window->isPrivate() || mainWindow->isPrivate())
+	{
+		return;
+	}
+
+	if (!isJournalActive())
+	{
+		markSessionAsModified();
+
+		return;
+	}
+
+	appendJournalRecord({{QLatin1String("type"), QLatin1String("moveTab")}, {QLatin1String("mainWindow"), m_journalMainWindows.indexOf(mainWindow->getIdentifier())}, {QLatin1String("index"), ((from < to) ? getJournalWindowIndex(mainWindow, from) : (getJournalWindowIndex(mainWindow, (from + 1)) - 1))}, {QLatin1String("to"), getJournalWindowIndex(mainWindow, to)}});
+}
+
+void SessionsManager::journalWindowHistory(const Window *window)
+{
+	const MainWindow *mainWindow(window->getMainWindow());
+
+	if (window->isPrivate() || !mainWindow || mainWindow->isPrivate())
+	{
+		return;
+	}
+
+	if (!isJournalActive())
+	{
+		markWindowAsModified(window->getIdentifier());
+
+		return;
+	}
+
+	const Session::Window::History history(window->getHistory());
+
+	if (history.index < 0 || history.index >= history.entries.count())
+	{
+		return;
+	}
+
+	const Session::Window::History::Entry &entry(history.entries.at(history.index));
+	JournalHistoryState &state(m_journalHistoryStates[window->getIdentifier()]);
+
+	if (state.amount == history.entries.count() && state.index == history.index && state.url == entry.url && state.title == entry.title)
+	{
+		return;
+	}
+
+	const bool isIndexChange(state.amount == history.entries.count() && state.index != history.index);
+
+	state.amount = history.entries.count();
+	state.index = history.index;
+	state.url = entry.url;
+	state.title = entry.title;
+
+	m_modifiedWindows.insert(window->getIdentifier());
+
+	appendJournalRecord({{QLatin1String("type"), (isIndexChange ? QLatin1String("historyIndex") : QLatin1String("navigate"))}, {QLatin1String("mainWindow"), m_journalMainWindows.indexOf(mainWindow->getIdentifier())}, {QLatin1String("index"), getJournalWindowIndex(mainWindow, mainWindow->getWindowIndex(window->getIdentifier()))}, {QLatin1String("historyIndex"), history.index}, {QLatin1String("amount"), history.entries.count()}, {QLatin1String("url"), entry.url}, {QLatin1String("title"), entry.title}});
+}
+
+void SessionsManager::queueWindowsRestoration(const QVector<Window*> &windows)
+{
+	for (int i = 0; i < windows.count(); ++i)
+	{
+		m_restorationQueue.append(windows.at(i));
+	}
+
+	const auto getPriority([](const Window *window)
+	{
+		const MainWindow *mainWindow(window->getMainWindow());
+
+		if (mainWindow && mainWindow->getActiveWindow() == window)
+		{
+			return 0;
+		}
+
+		return (window->isPinned() ? 1 : 2);
+	});
+
+	std::stable_sort(m_restorationQueue.begin(), m_restorationQueue.end(), [&](const QPointer<Window> &first, const QPointer<Window> &second)
+	{
+		if (!first || !second)
+		{
+			return (first && !second);
+		}
+
+		const int firstPriority(getPriority(first));
+		const int secondPriority(getPriority(second));
+
+		if (firstPriority != secondPriority)
+		{
+			return (firstPriority < secondPriority);
+		}
+
+		return (first->getLastActivity() > second->getLastActivity());
+	});
+
+	m_instance->processRestorationQueue();
+}
+
+void SessionsManager::saveCurrentSession()
+{
+	const QStringList excludedOptions(SettingsManager::getOption(SettingsManager::Sessions_OptionsExludedFromSavingOption).toStringList());
+
+	if (excludedOptions != m_excludedOptions)
+	{
+		m_excludedOptions = excludedOptions;
+
+		m_windowObjects.clear();
+	}
+
+	const QVector<MainWindow*> mainWindows(Application::getWindows());
+	QVector<quint64> journalMainWindows;
+	QHash<quint64, QJsonObject> windowObjects;
+	QJsonArray mainWindowsArray;
+
+	for (int i = 0; i < mainWindows.count(); ++i)
+	{
+		const MainWindow *mainWindow(mainWindows.at(i));
+
+		if (mainWindow->isPrivate())
+		{
+			continue;
+		}
+
+		const int currentIndex(mainWindow->getCurrentWindowIndex());
+		QJsonArray windowsArray;
+
+		for (int j = 0; j < mainWindow->getWindowCount(); ++j)
+		{
+			const Window *window(mainWindow->getWindowByIndex(j));
+
+			if (!window || window->isPrivate())
+			{
+				continue;
+			}
+
+			const quint64 identifier(window->getIdentifier());
+
+			if (j == currentIndex || m_modifiedWindows.contains(identifier) || !m_windowObjects.contains(identifier))
+			{
+				windowObjects[identifier] = createWindowObject(window->getSession(), excludedOptions);
+			}
+			else
+			{
+				windowObjects[identifier] = m_windowObjects[identifier];
+			}
+
+			windowsArray.append(windowObjects[identifier]);
+		}
+
+		journalMainWindows.append(mainWindow->isSessionRestored() ? mainWindow->getIdentifier() : 0);
+		mainWindowsArray.append(createMainWindowObject(mainWindow->getSession(false), windowsArray));
+	}
+
+	m_windowObjects = windowObjects;
+	m_modifiedWindows.clear();
+
+	if (mainWindowsArray.isEmpty())
+	{
+		return;
+	}
+
+	QDir().mkpath(m_profilePath + QLatin1String("/sessions/"));
+
+	if (m_saveFuture.isRunning())
+	{
+		m_saveFuture.waitForFinished();
+	}
+
+	if (m_isCheckpointPending)
+	{
+		m_isCheckpointPending = false;
+
+		if (m_saveFuture.result())
+		{
+			pruneJournal(m_checkpointSequence);
+		}
+	}
+
+	const bool needsReset(!m_journalFile || journalMainWindows != m_journalMainWindows);
+
+	if (needsReset)
+	{
+		closeJournal();
+
+		m_journalGeneration = QDateTime::currentMSecsSinceEpoch();
+		m_journalSequence = 0;
+	}
+
+	m_journalMainWindows = journalMainWindows;
+
+	const QJsonObject sessionObject({{QLatin1String("title"), m_sessionTitle}, {QLatin1String("currentIndex"), 1}, {QLatin1String("isClean"), false}, {QLatin1String("journal"), QJsonObject({{QLatin1String("generation"), static_cast<double>(m_journalGeneration)}, {QLatin1String("sequence"), static_cast<double>(m_journalSequence)}})}, {QLatin1String("windows"), mainWindowsArray}});
+
+	if (needsReset)
+	{
+		if (writeSession(getSessionPath({}), sessionObject))
+		{
+			openJournal();
+		}
+
+		return;
+	}
+
+	m_checkpointSequence = m_journalSequence;
+	m_isCheckpointPending = true;
+	m_saveFuture = QtConcurrent::run(&SessionsManager::writeSession, getSessionPath({}), sessionObject);
+}
+
+void SessionsManager::openJournal()
+{
+	m_journalFile = new QFile(getJournalPath({}));
+
+	if (!m_journalFile->open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		delete m_journalFile;
+
+		m_journalFile = nullptr;
+
+		return;
+	}
+
+	m_journalFile->write(QJsonDocument(QJsonObject({{QLatin1String("generation"), static_cast<double>(m_journalGeneration)}})).toJson(QJsonDocument::Compact) + '\n');
+	m_journalFile->flush();
+}
+
+void SessionsManager::closeJournal()
+{
+	if (m_journalFile)
+	{
+		m_journalFile->close();
+
+		delete m_journalFile;
+
+		m_journalFile = nullptr;
+	}
+
+	m_journalRecords.clear();
+	m_journalHistoryStates.clear();
+
+	m_isCheckpointPending = false;
+}
+
+void SessionsManager::pruneJournal(quint64 sequence)
+{
+	if (!m_journalFile || m_journalRecords.isEmpty() || m_journalRecords.first().first > sequence)
+	{
+		return;
+	}
+
+	while (!m_journalRecords.isEmpty() && m_journalRecords.first().first <= sequence)
+	{
+		m_journalRecords.removeFirst();
+	}
+
+	m_journalFile->close();
+
+	QSaveFile file(m_journalFile->fileName());
+
+	if (file.open(QIODevice::WriteOnly))
+	{
+		file.write(QJsonDocument(QJsonObject({{QLatin1String("generation"), static_cast<double>(m_journalGeneration)}})).toJson(QJsonDocument::Compact) + '\n');
+
+		for (int i = 0; i < m_journalRecords.count(); ++i)
+		{
+			file.write(m_journalRecords.at(i).second);
+		}
+
+		file.commit();
+	}
+
+	if (!m_journalFile->open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		closeJournal();
+	}
+}
+
+void SessionsManager::appendJournalRecord(QJsonObject record)
+{
+	++m_journalSequence;
+
+	record.insert(QLatin1String("sequence"), static_cast<double>(m_journalSequence));
+
+	const QByteArray data(QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n');
+
+	m_journalFile->write(data);
+	m_journalFile->flush();
 
-	emit m_instance->closedWindowsChanged();
+	m_journalRecords.append({m_journalSequence, data});
+
+	m_isDirty = true;
+
+	m_instance->scheduleSave((m_journalRecords.count() >= SESSION_JOURNAL_RECORDS_LIMIT) ? SESSION_SAVE_DELAY : SESSION_CHECKPOINT_INTERVAL);
 }
 
-void SessionsManager::storeClosedWindow(MainWindow *mainWindow)
+void SessionsManager::replayJournal(SessionInformation *session, const QJsonObject &journalObject)
 {
-	if (!mainWindow || mainWindow->isPrivate())
+	QFile file(getJournalPath(session->path));
+
+	if (!file.open(QIODevice::ReadOnly) || QJsonDocument::fromJson(file.readLine()).object().value(QLatin1String("generation")).toDouble() != journalObject.value(QLatin1String("generation")).toDouble())
 	{
 		return;
 	}
 
-	const Session::MainWindow session(mainWindow->getSession());
+	const double sequence(journalObject.value(QLatin1String("sequence")).toDouble());
 
-	if (session.windows.isEmpty())
+	while (!file.atEnd())
 	{
-		return;
-	}
+		const QJsonObject record(QJsonDocument::fromJson(file.readLine()).object());
 
-	const int limit(SettingsManager::getOption(SettingsManager::History_ClosedTabsLimitAmountOption).toInt());
+		if (record.isEmpty())
+		{
+			break;
+		}
 
-	m_closedWindows.prepend(session);
+		const int mainWindowIndex(record.value(QLatin1String("mainWindow")).toInt(-1));
 
-	if (m_closedWindows.count() > limit)
-	{
-		m_closedWindows.resize(limit);
-		m_closedWindows.squeeze();
-	}
+		if (record.value(QLatin1String("sequence")).toDouble() <= sequence || mainWindowIndex < 0 || mainWindowIndex >= session->windows.count())
+		{
+			continue;
+		}
 
-	emit m_instance->closedWindowsChanged();
-}
+		Session::MainWindow &mainWindow(session->windows[mainWindowIndex]);
+		const QString type(record.value(QLatin1String("type")).toString());
+		const int index(record.value(QLatin1String("index")).toInt(-1));
 
-void SessionsManager::markSessionAsModified()
-{
-	if (!m_isPrivate && !m_isDirty && m_sessionPath == QLatin1String("default"))
-	{
-		m_isDirty = true;
+		if (type == QLatin1String("openTab"))
+		{
+			if (index >= 0 && index <= mainWindow.windows.count())
+			{
+				mainWindow.windows.insert(index, readWindowObject(record.value(QLatin1String("window")).toObject()));
+
+				if (mainWindow.index >= index)
+				{
+					++mainWindow.index;
+				}
+			}
+
+			continue;
+		}
+
+		if (index < 0 || index >= mainWindow.windows.count())
+		{
+			continue;
+		}
+
+		if (type == QLatin1String("closeTab"))
+		{
+			mainWindow.windows.removeAt(index);
+
+			if (mainWindow.index > index)
+			{
+				--mainWindow.index;
+			}
+		}
+		else if (type == QLatin1String("moveTab"))
+		{
+			const int targetIndex(record.value(QLatin1String("to")).toInt(-1));
+
+			if (targetIndex < 0 || targetIndex >= mainWindow.windows.count())
+			{
+				continue;
+			}
+
+			mainWindow.windows.move(index, targetIndex);
+
+			if (mainWindow.index == index)
+			{
+				mainWindow.index = targetIndex;
+			}
+			else if (index < mainWindow.index && targetIndex >= mainWindow.index)
+			{
+				--mainWindow.index;
+			}
+			else if (index > mainWindow.index && targetIndex <= mainWindow.index)
+			{
+				++mainWindow.index;
+			}
+		}
+		else if (type == QLatin1String("navigate") || type == QLatin1String("historyIndex"))
+		{
+			const int historyIndex(record.value(QLatin1String("historyIndex")).toInt(-1));
+			const int amount(record.value(QLatin1String("amount")).toInt());
+			const QString url(record.value(QLatin1String("url")).toString());
+			Session::Window::History &history(mainWindow.windows[index].history);
+
+			if (historyIndex < 0 || historyIndex >= amount)
+			{
+				continue;
+			}
 
-		m_instance->scheduleSave();
+			history.entries.resize(amount);
+
+			if (history.entries.at(historyIndex).url != url)
+			{
+				history.entries[historyIndex] = Session::Window::History::Entry();
+				history.entries[historyIndex].url = url;
+			}
+
+			history.entries[historyIndex].title = record.value(QLatin1String("title")).toString();
+			history.index = historyIndex;
+		}
+	}
+
+	for (int i = 0; i < session->windows.count(); ++i)
+	{
+		if (session->windows.at(i).index < 0 || session->windows.at(i).index >= session->windows.at(i).windows.count())
+		{
+			session->windows[i].index = (session->windows.at(i).windows.count() - 1);
+		}
 	}
 }
 
@@ -209,6 +822,14 @@ QString SessionsManager::getSessionPath(const QString &path, bool isBound)
 	return QDir::toNativeSeparators(m_profilePath + QLatin1String("/sessions/") + normalizedPath);
 }
 
+QString SessionsManager::getJournalPath(const QString &path)
+{
+	QString journalPath(getSessionPath(path));
+	journalPath.chop(4);
+
+	return journalPath + QLatin1String("journal");
+}
+
 Session::Identity SessionsManager::getIdentity(const QString &name)
 {
 	return m_identities.value(name);
@@ -227,7 +848,6 @@ SessionInformation SessionsManager::getSession(const QString &path)
 		return session;
 	}
 
-	const int defaultZoom(SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption).toInt());
 	const QJsonArray mainWindowsArray(settings.object().value(QLatin1String("windows")).toArray());
 
 	session.path = path;
@@ -245,55 +865,7 @@ SessionInformation SessionsManager::getSession(const QString &path)
 
 		for (int j = 0; j < windowsArray.count(); ++j)
 		{
-			const QJsonObject windowObject(windowsArray.at(j).toObject());
-			const QJsonArray windowHistoryArray(windowObject.value(QLatin1String("history")).toArray());
-			const QString state(windowObject.value(QLatin1String("state")).toString());
-			Session::Window sessionWindow;
-			sessionWindow.identity = windowObject.value(QLatin1String("identity")).toString();
-			sessionWindow.state.geometry = JsonSettings::readRectangle(windowObject.value(QLatin1String("geometry")).toVariant());
-			sessionWindow.state.state = ((state == QLatin1String("maximized")) ? Qt::WindowMaximized : ((state == QLatin1String("minimized")) ? Qt::WindowMinimized : Qt::WindowNoState));
-			sessionWindow.history.index = (windowObject.value(QLatin1String("currentIndex")).toInt(1) - 1);
-			sessionWindow.isAlwaysOnTop = windowObject.value(QLatin1String("isAlwaysOnTop")).toBool(false);
-			sessionWindow.isPinned = windowObject.value(QLatin1String("isPinned")).toBool(false);
-
-			if (windowObject.contains(QLatin1String("options")))
-			{
-				const QJsonObject optionsObject(windowObject.value(QLatin1String("options")).toObject());
-				QJsonObject::const_iterator iterator;
-
-				for (iterator = optionsObject.constBegin(); iterator != optionsObject.constEnd(); ++iterator)
-				{
-					const int optionIdentifier(SettingsManager::getOptionIdentifier(iterator.key()));
-
-					if (optionIdentifier >= 0)
-					{
-						sessionWindow.options[optionIdentifier] = iterator.value().toVariant();
-					}
-				}
-			}
-
-			Session::Window::History history;
-
-			for (int k = 0; k < windowHistoryArray.count(); ++k)
-			{
-				const QJsonObject historyEntryObject(windowHistoryArray.at(k).toObject());
-				const QStringList position(historyEntryObject.value(QLatin1String("position")).toString().split(QLatin1Char(',')));
-				Session::Window::History::Entry historyEntry;
-				historyEntry.url = historyEntryObject.value(QLatin1String("url")).toString();
-				historyEntry.title = historyEntryObject.value(QLatin1String("title")).toString();
-				historyEntry.position = ((position.count() == 2) ? QPoint(position.at(0).simplified().toInt(), position.at(1).simplified().toInt()) : QPoint(0, 0));
-				historyEntry.zoom = historyEntryObject.value(QLatin1String("zoom")).toInt(defaultZoom);
-
-				history.entries.append(historyEntry);
-			}
-
-			if (history.index < 0 || history.index >= history.entries.count())
-			{
-				history.index = (history.entries.count() - 1);
-			}
-
-			sessionWindow.history = history;
-			sessionMainWindow.windows.append(sessionWindow);
+			sessionMainWindow.windows.append(readWindowObject(windowsArray.at(j).toObject()));
 		}
 
 		if (sessionMainWindow.index < 0 || sessionMainWindow.index >= sessionMainWindow.windows.count())
@@ -390,6 +962,11 @@ SessionInformation SessionsManager::getSession(const QString &path)
 		session.windows.append(sessionMainWindow);
 	}
 
+	if (!session.isClean && settings.object().contains(QLatin1String("journal")))
+	{
+		replayJournal(&session, settings.object().value(QLatin1String("journal")).toObject());
+	}
+
 	if (session.index < 0 || session.index >= session.windows.count())
 	{
 		session.index = (session.windows.count() - 1);
@@ -668,189 +1245,280 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 	for (int i = 0; i < session.windows.count(); ++i)
 	{
 		const Session::MainWindow sessionEntry(session.windows.at(i));
-		QJsonObject mainWindowObject({{QLatin1String("currentIndex"), (sessionEntry.index + 1)}, {QLatin1String("geometry"), QString::fromLatin1(sessionEntry.geometry.toBase64())}});
 		QJsonArray windowsArray;
 
 		for (int j = 0; j < sessionEntry.windows.count(); ++j)
 		{
-			QJsonObject windowObject({{QLatin1String("currentIndex"), (sessionEntry.windows.at(j).history.index + 1)}});
+			windowsArray.append(createWindowObject(sessionEntry.windows.at(j), excludedOptions));
+		}
 
-			if (!sessionEntry.windows.at(j).identity.isEmpty())
-			{
-				windowObject.insert(QLatin1String("identity"), sessionEntry.windows.at(j).identity);
-			}
+		mainWindowsArray.append(createMainWindowObject(sessionEntry, windowsArray));
+	}
 
-			if (!sessionEntry.windows.at(j).options.isEmpty())
-			{
-				const QHash<int, QVariant> windowOptions(sessionEntry.windows.at(j).options);
-				QHash<int, QVariant>::const_iterator optionsIterator;
-				QJsonObject optionsObject;
+	sessionObject.insert(QLatin1String("windows"), mainWindowsArray);
 
-				for (optionsIterator = windowOptions.constBegin(); optionsIterator != windowOptions.constEnd(); ++optionsIterator)
-				{
-					const QString optionName(SettingsManager::getOptionName(optionsIterator.key()));
+	if (m_saveFuture.isRunning())
+	{
+		m_saveFuture.waitForFinished();
+	}
 
-					if (!optionName.isEmpty() && !excludedOptions.contains(optionName))
-					{
-						optionsObject.insert(optionName, QJsonValue::fromVariant(optionsIterator.value()));
-					}
-				}
+	if (!writeSession(path, sessionObject))
+	{
+		return false;
+	}
 
-				windowObject.insert(QLatin1String("options"), optionsObject);
-			}
+	if (m_journalFile && path == getSessionPath({}))
+	{
+		closeJournal();
 
-			switch (sessionEntry.windows.at(j).state.state)
-			{
-				case Qt::WindowMaximized:
-					windowObject.insert(QLatin1String("state"), QLatin1String("maximized"));
+		QFile::remove(getJournalPath({}));
+	}
 
-					break;
-				case Qt::WindowMinimized:
-					windowObject.insert(QLatin1String("state"), QLatin1String("minimized"));
+	return true;
+}
 
-					break;
-				default:
-					{
-						const QRect geometry(sessionEntry.windows.at(j).state.geometry);
+bool SessionsManager::writeSession(const QString &path, const QJsonObject &sessionObject)
+{
+	JsonSettings settings;
+	settings.setObject(sessionObject);
 
-						windowObject.insert(QLatin1String("state"), QLatin1String("normal"));
+	return settings.save(path);
+}
 
-						if (geometry.isValid())
-						{
-							windowObject.insert(QLatin1String("geometry"), QStringLiteral("%1, %2, %3, %4").arg(geometry.x()).arg(geometry.y()).arg(geometry.width()).arg(geometry.height()));
-						}
-					}
+Session::Window SessionsManager::readWindowObject(const QJsonObject &windowObject)
+{
+	const QJsonArray windowHistoryArray(windowObject.value(QLatin1String("history")).toArray());
+	const QString state(windowObject.value(QLatin1String("state")).toString());
+	const int defaultZoom(SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption).toInt());
+	Session::Window sessionWindow;
+	sessionWindow.identity = windowObject.value(QLatin1String("identity")).toString();
+	sessionWindow.state.geometry = JsonSettings::readRectangle(windowObject.value(QLatin1String("geometry")).toVariant());
+	sessionWindow.state.state = ((state == QLatin1String("maximized")) ? Qt::WindowMaximized : ((state == QLatin1String("minimized")) ? Qt::WindowMinimized : Qt::WindowNoState));
+	sessionWindow.history.index = (windowObject.value(QLatin1String("currentIndex")).toInt(1) - 1);
+	sessionWindow.lastActivity = QDateTime::fromString(windowObject.value(QLatin1String("lastActivity")).toString(), Qt::ISODate);
+	sessionWindow.isAlwaysOnTop = windowObject.value(QLatin1String("isAlwaysOnTop")).toBool(false);
+	sessionWindow.isPinned = windowObject.value(QLatin1String("isPinned")).toBool(false);
+
+	if (windowObject.contains(QLatin1String("options")))
+	{
+		const QJsonObject optionsObject(windowObject.value(QLatin1String("options")).toObject());
+		QJsonObject::const_iterator iterator;
 
-					break;
-			}
+		for (iterator = optionsObject.constBegin(); iterator != optionsObject.constEnd(); ++iterator)
+		{
+			const int optionIdentifier(SettingsManager::getOptionIdentifier(iterator.key()));
 
-			if (sessionEntry.windows.at(j).isAlwaysOnTop)
+			if (optionIdentifier >= 0)
 			{
-				windowObject.insert(QLatin1String("isAlwaysOnTop"), true);
+				sessionWindow.options[optionIdentifier] = iterator.value().toVariant();
 			}
+		}
+	}
+
+	Session::Window::History history;
+
+	for (int i = 0; i < windowHistoryArray.count(); ++i)
+	{
+		const QJsonObject historyEntryObject(windowHistoryArray.at(i).toObject());
+		const QStringList position(historyEntryObject.value(QLatin1String("position")).toString().split(QLatin1Char(',')));
+		Session::Window::History::Entry historyEntry;
+		historyEntry.url = historyEntryObject.value(QLatin1String("url")).toString();
+		historyEntry.title = historyEntryObject.value(QLatin1String("title")).toString();
+		historyEntry.position = ((position.count() == 2) ? QPoint(position.at(0).simplified().toInt(), position.at(1).simplified().toInt()) : QPoint(0, 0));
+		historyEntry.zoom = historyEntryObject.value(QLatin1String("zoom")).toInt(defaultZoom);
+
+		history.entries.append(historyEntry);
+	}
+
+	if (history.index < 0 || history.index >= history.entries.count())
+	{
+		history.index = (history.entries.count() - 1);
+	}
 
-			if (sessionEntry.windows.at(j).isPinned)
+	sessionWindow.history = history;
+
+	return sessionWindow;
+}
+
+QJsonObject SessionsManager::createWindowObject(const Session::Window &window, const QStringList &excludedOptions)
+{
+	QJsonObject windowObject({{QLatin1String("currentIndex"), (window.history.index + 1)}});
+
+	if (!window.identity.isEmpty())
+	{
+		windowObject.insert(QLatin1String("identity"), window.identity);
+	}
+
+	if (!window.options.isEmpty())
+	{
+		const QHash<int, QVariant> windowOptions(window.options);
+		QHash<int, QVariant>::const_iterator optionsIterator;
+		QJsonObject optionsObject;
+
+		for (optionsIterator = windowOptions.constBegin(); optionsIterator != windowOptions.constEnd(); ++optionsIterator)
+		{
+			const QString optionName(SettingsManager::getOptionName(optionsIterator.key()));
+
+			if (!optionName.isEmpty() && !excludedOptions.contains(optionName))
 			{
-				windowObject.insert(QLatin1String("isPinned"), true);
+				optionsObject.insert(optionName, QJsonValue::fromVariant(optionsIterator.value()));
 			}
+		}
+
+		windowObject.insert(QLatin1String("options"), optionsObject);
+	}
+
+	switch (window.state.state)
+	{
+		case Qt::WindowMaximized:
+			windowObject.insert(QLatin1String("state"), QLatin1String("maximized"));
 
-			const Session::Window::History windowHistory(sessionEntry.windows.at(j).history);
-			QJsonArray windowHistoryArray;
+			break;
+		case Qt::WindowMinimized:
+			windowObject.insert(QLatin1String("state"), QLatin1String("minimized"));
 
-			for (int k = 0; k < windowHistory.entries.count(); ++k)
+			break;
+		default:
 			{
-				const QPoint position(windowHistory.entries.at(k).position);
-				QJsonObject historyEntryObject({{QLatin1String("url"), windowHistory.entries.at(k).url}, {QLatin1String("title"), windowHistory.entries.at(k).title}, {QLatin1String("zoom"), windowHistory.entries.at(k).zoom}});
+				const QRect geometry(window.state.geometry);
+
+				windowObject.insert(QLatin1String("state"), QLatin1String("normal"));
 
-				if (!position.isNull())
+				if (geometry.isValid())
 				{
-					historyEntryObject.insert(QLatin1String("position"), QStringLiteral("%1, %2").arg(position.x()).arg(position.y()));
+					windowObject.insert(QLatin1String("geometry"), QStringLiteral("%1, %2, %3, %4").arg(geometry.x()).arg(geometry.y()).arg(geometry.width()).arg(geometry.height()));
 				}
-
-				windowHistoryArray.append(historyEntryObject);
 			}
 
-			windowObject.insert(QLatin1String("history"), windowHistoryArray);
+			break;
+	}
+
+	if (window.lastActivity.isValid())
+	{
+		windowObject.insert(QLatin1String("lastActivity"), window.lastActivity.toString(Qt::ISODate));
+	}
 
-			windowsArray.append(windowObject);
-		}
+	if (window.isAlwaysOnTop)
+	{
+		windowObject.insert(QLatin1String("isAlwaysOnTop"), true);
+	}
+
+	if (window.isPinned)
+	{
+		windowObject.insert(QLatin1String("isPinned"), true);
+	}
+
+	const Session::Window::History windowHistory(window.history);
+	QJsonArray windowHistoryArray;
 
-		mainWindowObject.insert(QLatin1String("windows"), windowsArray);
+	for (int i = 0; i < windowHistory.entries.count(); ++i)
+	{
+		const QPoint position(windowHistory.entries.at(i).position);
+		QJsonObject historyEntryObject({{QLatin1String("url"), windowHistory.entries.at(i).url}, {QLatin1String("title"), windowHistory.entries.at(i).title}, {QLatin1String("zoom"), windowHistory.entries.at(i).zoom}});
 
-		if (sessionEntry.hasToolBarsState)
+		if (!position.isNull())
 		{
-			QJsonArray toolBarsArray;
+			historyEntryObject.insert(QLatin1String("position"), QStringLiteral("%1, %2").arg(position.x()).arg(position.y()));
+		}
 
-			for (int j = 0; j < sessionEntry.toolBars.count(); ++j)
-			{
-				const QString identifier(ToolBarsManager::getToolBarName(sessionEntry.toolBars.at(j).identifier));
+		windowHistoryArray.append(historyEntryObject);
+	}
 
-				if (identifier.isEmpty())
-				{
-					continue;
-				}
+	windowObject.insert(QLatin1String("history"), windowHistoryArray);
 
-				QJsonObject toolBarObject({{QLatin1String("identifier"), identifier}});
-				QString location;
+	return windowObject;
+}
 
-				switch (sessionEntry.toolBars.at(j).location)
-				{
-					case Qt::LeftToolBarArea:
-						location = QLatin1String("left");
+QJsonObject SessionsManager::createMainWindowObject(const Session::MainWindow &mainWindow, const QJsonArray &windowsArray)
+{
+	QJsonObject mainWindowObject({{QLatin1String("currentIndex"), (mainWindow.index + 1)}, {QLatin1String("geometry"), QString::fromLatin1(mainWindow.geometry.toBase64())}, {QLatin1String("windows"), windowsArray}});
 
-						break;
-					case Qt::RightToolBarArea:
-						location = QLatin1String("right");
+	if (mainWindow.hasToolBarsState)
+	{
+		QJsonArray toolBarsArray;
 
-						break;
-					case Qt::TopToolBarArea:
-						location = QLatin1String("top");
+		for (int i = 0; i < mainWindow.toolBars.count(); ++i)
+		{
+			const QString identifier(ToolBarsManager::getToolBarName(mainWindow.toolBars.at(i).identifier));
 
-						break;
-					case Qt::BottomToolBarArea:
-						location = QLatin1String("bottom");
+			if (identifier.isEmpty())
+			{
+				continue;
+			}
 
-						break;
-					default:
-						break;
-				}
+			QJsonObject toolBarObject({{QLatin1String("identifier"), identifier}});
+			QString location;
 
-				if (!location.isEmpty())
-				{
-					toolBarObject.insert(QLatin1String("location"), location);
-				}
+			switch (mainWindow.toolBars.at(i).location)
+			{
+				case Qt::LeftToolBarArea:
+					location = QLatin1String("left");
 
-				if (sessionEntry.toolBars.at(j).normalVisibility != Session::MainWindow::ToolBarState::UnspecifiedVisibilityToolBar)
-				{
-					toolBarObject.insert(QLatin1String("normalVisibility"), ((sessionEntry.toolBars.at(j).normalVisibility == Session::MainWindow::ToolBarState::AlwaysHiddenToolBar) ? QLatin1String("hidden") : QLatin1String("visible")));
-				}
+					break;
+				case Qt::RightToolBarArea:
+					location = QLatin1String("right");
 
-				if (sessionEntry.toolBars.at(j).fullScreenVisibility != Session::MainWindow::ToolBarState::UnspecifiedVisibilityToolBar)
-				{
-					toolBarObject.insert(QLatin1String("fullScreenVisibility"), ((sessionEntry.toolBars.at(j).fullScreenVisibility == Session::MainWindow::ToolBarState::AlwaysHiddenToolBar) ? QLatin1String("hidden") : QLatin1String("visible")));
-				}
+					break;
+				case Qt::TopToolBarArea:
+					location = QLatin1String("top");
 
-				if (sessionEntry.toolBars.at(j).row >= 0)
-				{
-					toolBarObject.insert(QLatin1String("row"), sessionEntry.toolBars.at(j).row);
-				}
+					break;
+				case Qt::BottomToolBarArea:
+					location = QLatin1String("bottom");
 
-				toolBarsArray.append(toolBarObject);
+					break;
+				default:
+					break;
 			}
 
-			mainWindowObject.insert(QLatin1String("toolBars"), toolBarsArray);
-		}
-
-		if (!sessionEntry.splitters.isEmpty())
-		{
-			QJsonArray splittersArray;
-			QMap<QString, QVector<int> >::const_iterator iterator;
+			if (!location.isEmpty())
+			{
+				toolBarObject.insert(QLatin1String("location"), location);
+			}
 
-			for (iterator = sessionEntry.splitters.begin(); iterator != sessionEntry.splitters.end(); ++iterator)
+			if (mainWindow.toolBars.at(i).normalVisibility != Session::MainWindow::ToolBarState::UnspecifiedVisibilityToolBar)
 			{
-				QJsonArray sizesArray;
-				const QVector<int> &sizes(iterator.value());
+				toolBarObject.insert(QLatin1String("normalVisibility"), ((mainWindow.toolBars.at(i).normalVisibility == Session::MainWindow::ToolBarState::AlwaysHiddenToolBar) ? QLatin1String("hidden") : QLatin1String("visible")));
+			}
 
-				for (int j = 0; j < sizes.count(); ++j)
-				{
-					sizesArray.append(sizes.at(j));
-				}
+			if (mainWindow.toolBars.at(i).fullScreenVisibility != Session::MainWindow::ToolBarState::UnspecifiedVisibilityToolBar)
+			{
+				toolBarObject.insert(QLatin1String("fullScreenVisibility"), ((mainWindow.toolBars.at(i).fullScreenVisibility == Session::MainWindow::ToolBarState::AlwaysHiddenToolBar) ? QLatin1String("hidden") : QLatin1String("visible")));
+			}
 
-				splittersArray.append(QJsonObject({{QLatin1String("identifier"), iterator.key()}, {QLatin1String("sizes"), sizesArray}}));
+			if (mainWindow.toolBars.at(i).row >= 0)
+			{
+				toolBarObject.insert(QLatin1String("row"), mainWindow.toolBars.at(i).row);
 			}
 
-			mainWindowObject.insert(QLatin1String("splitters"), splittersArray);
+			toolBarsArray.append(toolBarObject);
 		}
 
-		mainWindowsArray.append(mainWindowObject);
+		mainWindowObject.insert(QLatin1String("toolBars"), toolBarsArray);
 	}
 
-	sessionObject.insert(QLatin1String("windows"), mainWindowsArray);
+	if (!mainWindow.splitters.isEmpty())
+	{
+		QJsonArray splittersArray;
+		QMap<QString, QVector<int> >::const_iterator iterator;
 
-	JsonSettings settings;
-	settings.setObject(sessionObject);
+		for (iterator = mainWindow.splitters.begin(); iterator != mainWindow.splitters.end(); ++iterator)
+		{
+			QJsonArray sizesArray;
+			const QVector<int> &sizes(iterator.value());
 
-	return settings.save(path);
+			for (int i = 0; i < sizes.count(); ++i)
+			{
+				sizesArray.append(sizes.at(i));
+			}
+
+			splittersArray.append(QJsonObject({{QLatin1String("identifier"), iterator.key()}, {QLatin1String("sizes"), sizesArray}}));
+		}
+
+		mainWindowObject.insert(QLatin1String("splitters"), splittersArray);
+	}
+
+	return mainWindowObject;
 }
 
 bool SessionsManager::deleteSession(const QString &path)
@@ -865,6 +1533,53 @@ bool SessionsManager::deleteSession(const QString &path)
 	return false;
 }
 
+int SessionsManager::getJournalWindowIndex(const MainWindow *mainWindow, int index)
+{
+	int journalIndex(0);
+
+	for (int i = 0; i < index; ++i)
+	{
+		const Window *window(mainWindow->getWindowByIndex(i));
+
+		if (window && !window->isPrivate())
+		{
+			++journalIndex;
+		}
+	}
+
+	return journalIndex;
+}
+
+bool SessionsManager::isJournalActive()
+{
+	if (!m_journalFile || m_isPrivate || m_sessionPath != QLatin1String("default"))
+	{
+		return false;
+	}
+
+	const QVector<MainWindow*> mainWindows(Application::getWindows());
+	int index(0);
+
+	for (int i = 0; i < mainWindows.count(); ++i)
+	{
+		const MainWindow *mainWindow(mainWindows.at(i));
+
+		if (mainWindow->isPrivate())
+		{
+			continue;
+		}
+
+		if (!mainWindow->isSessionRestored() || index >= m_journalMainWindows.count() || m_journalMainWindows.at(index) != mainWindow->getIdentifier())
+		{
+			return false;
+		}
+
+		++index;
+	}
+
+	return (index == m_journalMainWindows.count());
+}
+
 bool SessionsManager::isPrivate()
 {
 	return m_isPrivate;
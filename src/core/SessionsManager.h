@@ -27,6 +27,11 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFuture>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPointer>
 #include <QtCore/QRect>
 
 namespace Otter
@@ -34,6 +39,7 @@ namespace Otter
 
 class MainWindow;
 class SessionModel;
+class Window;
 
 class Session final : public QObject
 {
@@ -101,6 +107,7 @@ public:
 		History history;
 		State state;
 		QHash<int, QVariant> options;
+		QDateTime lastActivity;
 		int parentGroup = 0;
 		bool isAlwaysOnTop = false;
 		bool isPinned = false;
@@ -243,6 +250,12 @@ public:
 	static void clearClosedWindows();
 	static void storeClosedWindow(MainWindow *mainWindow);
 	static void markSessionAsModified();
+	static void markWindowAsModified(quint64 identifier);
+	static void journalWindowOpened(const Window *window);
+	static void journalWindowClosed(const Window *window);
+	static void journalWindowMoved(const MainWindow *mainWindow, int from, int to);
+	static void journalWindowHistory(const Window *window);
+	static void queueWindowsRestoration(const QVector<Window*> &windows);
 	static void removeStoredUrl(const QString &url);
 	static SessionsManager* getInstance();
 	static SessionModel* getModel();
@@ -272,11 +285,45 @@ public:
 protected:
 	explicit SessionsManager(QObject *parent);
 
+	struct JournalHistoryState final
+	{
+		QString url;
+		QString title;
+		int amount = 0;
+		int index = -1;
+	};
+
+	struct RestoringWindow final
+	{
+		QPointer<Window> window;
+		qint64 startTime = 0;
+		bool hasStarted = false;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
-	void scheduleSave();
+	void scheduleSave(int interval);
+	void processRestorationQueue();
+	static void saveCurrentSession();
+	static void openJournal();
+	static void closeJournal();
+	static void pruneJournal(quint64 sequence);
+	static void appendJournalRecord(QJsonObject record);
+	static void replayJournal(SessionInformation *session, const QJsonObject &journalObject);
+	static QString getJournalPath(const QString &path);
+	static Session::Window readWindowObject(const QJsonObject &windowObject);
+	static QJsonObject createWindowObject(const Session::Window &window, const QStringList &excludedOptions);
+	static QJsonObject createMainWindowObject(const Session::MainWindow &mainWindow, const QJsonArray &windowsArray);
+	static int getJournalWindowIndex(const MainWindow *mainWindow, int index);
+	static bool writeSession(const QString &path, const QJsonObject &sessionObject);
+	static bool isJournalActive();
+
+protected slots:
+	void handleRestoringWindowLoadingStateChanged();
 
 private:
+	int m_restorationTimer;
 	int m_saveTimer;
+	int m_saveInterval;
 
 	static SessionsManager *m_instance;
 	static SessionModel *m_model;
@@ -284,8 +331,22 @@ private:
 	static QString m_sessionTitle;
 	static QString m_cachePath;
 	static QString m_profilePath;
+	static QStringList m_excludedOptions;
 	static QHash<QString, Session::Identity> m_identities;
+	static QHash<quint64, QJsonObject> m_windowObjects;
+	static QHash<quint64, JournalHistoryState> m_journalHistoryStates;
+	static QSet<quint64> m_modifiedWindows;
 	static QVector<Session::MainWindow> m_closedWindows;
+	static QVector<QPair<quint64, QByteArray> > m_journalRecords;
+	static QVector<quint64> m_journalMainWindows;
+	static QVector<QPointer<Window> > m_restorationQueue;
+	static QVector<RestoringWindow> m_restoringWindows;
+	static QFile *m_journalFile;
+	static QFuture<bool> m_saveFuture;
+	static qint64 m_journalGeneration;
+	static quint64 m_journalSequence;
+	static quint64 m_checkpointSequence;
+	static bool m_isCheckpointPending;
 	static bool m_isDirty;
 	static bool m_isPrivate;
 	static bool m_isReadOnly;
@@ -85,6 +85,7 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(Browser_InactiveTabTimeUntilSuspendOption, IntegerType, -1);
 	registerOption(Browser_KeyboardShortcutsProfilesOrderOption, ListType, QStringList(QLatin1String("default")));
 	registerOption(Browser_LocaleOption, StringType, QLatin1String("system"));
+	registerOption(Browser_MemoryUsageLimitOption, IntegerType, -1);
 	registerOption(Browser_MessagesOption, ListType, QStringList());
 	registerOption(Browser_MigrationsOption, ListType, QStringList());
 	registerOption(Browser_MouseProfilesOrderOption, ListType, QStringList(QLatin1String("default")));
@@ -98,9 +99,14 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(Browser_ShowSelectionContextMenuOnDoubleClickOption, BooleanType, false);
 	registerOption(Browser_SpellCheckDictionaryOption, StringType, QString());
 	registerOption(Browser_StartupBehaviorOption, EnumerationType, QLatin1String("continuePrevious"), {QLatin1String("continuePrevious"), QLatin1String("showDialog"), QLatin1String("startHomePage"), QLatin1String("startStartPage"), QLatin1String("startEmpty")});
+	registerOption(Browser_TransferSegmentsAmountOption, IntegerType, 4);
 	registerOption(Browser_TransferStartingActionOption, EnumerationType, QLatin1String("doNothing"), {QLatin1String("openTab"), QLatin1String("openBackgroundTab"), QLatin1String("openPanel"), QLatin1String("doNothing")});
+	registerOption(Browser_TransfersBandwidthLimitOption, IntegerType, 0);
+	registerOption(Browser_TransfersLimitOption, IntegerType, 4);
+	registerOption(Browser_TransfersPerHostLimitOption, IntegerType, 2);
 	registerOption(Browser_ValidatorsOrderOption, ListType, QStringList({QLatin1String("w3c-markup"), QLatin1String("w3c-css")}));
 	registerOption(Cache_DiskCacheLimitOption, IntegerType, 51200);
+	registerOption(Cache_MemoryCacheLimitOption, IntegerType, 10240);
 	registerOption(Cache_PagesInMemoryLimitOption, IntegerType, 5);
 	registerOption(Choices_WarnFormResendOption, BooleanType, true);
 	registerOption(Choices_WarnLowDiskSpaceOption, EnumerationType, QLatin1String("warn"), {QLatin1String("warn"), QLatin1String("continueReadOnly"), QLatin1String("continueReadWrite")});
@@ -211,6 +217,7 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(Sessions_OpenInExistingWindowOption, BooleanType, false);
 	registerOption(Sessions_OptionsExludedFromInheritingOption, ListType, QStringList(QLatin1String("Content/PageReloadTime")));
 	registerOption(Sessions_OptionsExludedFromSavingOption, ListType, QStringList());
+	registerOption(Sessions_TabsLoadingLimitAmountOption, IntegerType, 3);
 	registerOption(SourceViewer_ShowLineNumbersOption, BooleanType, true);
 	registerOption(SourceViewer_WrapLinesOption, BooleanType, false);
 	registerOption(StartPage_BackgroundColorOption, ColorType, QColor());
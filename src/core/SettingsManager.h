@@ -61,6 +61,7 @@ public:
 		Browser_InactiveTabTimeUntilSuspendOption,
 		Browser_KeyboardShortcutsProfilesOrderOption,
 		Browser_LocaleOption,
+		Browser_MemoryUsageLimitOption,
 		Browser_MessagesOption,
 		Browser_MigrationsOption,
 		Browser_MouseProfilesOrderOption,
@@ -74,9 +75,14 @@ public:
 		Browser_ShowSelectionContextMenuOnDoubleClickOption,
 		Browser_SpellCheckDictionaryOption,
 		Browser_StartupBehaviorOption,
+		Browser_TransferSegmentsAmountOption,
 		Browser_TransferStartingActionOption,
+		Browser_TransfersBandwidthLimitOption,
+		Browser_TransfersLimitOption,
+		Browser_TransfersPerHostLimitOption,
 		Browser_ValidatorsOrderOption,
 		Cache_DiskCacheLimitOption,
+		Cache_MemoryCacheLimitOption,
 		Cache_PagesInMemoryLimitOption,
 		Choices_WarnFormResendOption,
 		Choices_WarnLowDiskSpaceOption,
@@ -187,6 +193,7 @@ public:
 		Sessions_OpenInExistingWindowOption,
 		Sessions_OptionsExludedFromInheritingOption,
 		Sessions_OptionsExludedFromSavingOption,
+		Sessions_TabsLoadingLimitAmountOption,
 		SourceViewer_ShowLineNumbersOption,
 		SourceViewer_WrapLinesOption,
 		StartPage_BackgroundColorOption,
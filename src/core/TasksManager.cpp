@@ -20,6 +20,7 @@
 #include "TasksManager.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QTimerEvent>
 
 namespace Otter
 {
@@ -69,6 +70,15 @@ void TasksManager::timerEvent(QTimerEvent *event)
 			const quint64 identifier(m_queue.dequeue());
 			const Task definition(m_tasks[identifier]);
 
+			if (definition.isRepeating)
+			{
+				m_tasks[identifier].nextRun = currentDateTime.addSecs(static_cast<qint64>(definition.interval) * 60);
+			}
+			else
+			{
+				m_tasks.remove(identifier);
+			}
+
 			if (definition.function && definition.object)
 			{
 				definition.function();
@@ -85,7 +95,29 @@ void TasksManager::timerEvent(QTimerEvent *event)
 
 void TasksManager::updateQueue()
 {
-///TODO
+	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
+	QMultiMap<QDateTime, quint64> tasks;
+	QMap<quint64, Task>::iterator iterator;
+
+	for (iterator = m_tasks.begin(); iterator != m_tasks.end(); ++iterator)
+	{
+		if (!iterator.value().nextRun.isValid())
+		{
+			iterator.value().nextRun = currentDateTime.addSecs(static_cast<qint64>(iterator.value().interval) * 60);
+		}
+
+		tasks.insert(iterator.value().nextRun, iterator.key());
+	}
+
+	m_queue = QQueue<quint64>();
+	m_queue.reserve(tasks.count());
+
+	QMultiMap<QDateTime, quint64>::const_iterator tasksIterator;
+
+	for (tasksIterator = tasks.constBegin(); tasksIterator != tasks.constEnd(); ++tasksIterator)
+	{
+		m_queue.enqueue(tasksIterator.value());
+	}
 }
 
 void TasksManager::updateTask(quint64 identifier, int interval, bool isRepeating)
@@ -97,6 +129,7 @@ void TasksManager::updateTask(quint64 identifier, int interval, bool isRepeating
 
 	m_tasks[identifier].interval = interval;
 	m_tasks[identifier].isRepeating = isRepeating;
+	m_tasks[identifier].nextRun = {};
 
 	updateQueue();
 }
@@ -26,18 +26,20 @@
 #ifdef Q_OS_WIN32
 #include <QtCore/QAbstractEventDispatcher>
 #endif
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
-#include <QtGui/QIcon>
 #include <QtWidgets/QWidget>
 
 #ifdef Q_OS_WIN32
 #include <windows.h>
 #endif
 
+#define THEMES_DATA_URI_ICONS_CACHE_LIMIT 500
+
 namespace Otter
 {
 
@@ -118,6 +120,9 @@ ThemesManager* ThemesManager::m_instance(nullptr);
 ColorScheme* ThemesManager::m_colorScheme(nullptr);
 QWidget* ThemesManager::m_probeWidget(nullptr);
 QString ThemesManager::m_iconThemePath(QLatin1String(":/icons/theme/"));
+QHash<QPair<QString, bool>, QIcon> ThemesManager::m_icons;
+QCache<QByteArray, QIcon> ThemesManager::m_dataUriIcons(THEMES_DATA_URI_ICONS_CACHE_LIMIT);
+ThemesManager::IconsCacheStatistics ThemesManager::m_iconsCacheStatistics;
 bool ThemesManager::m_useSystemIconTheme(false);
 
 ThemesManager::ThemesManager(QObject *parent) : QObject(parent)
@@ -129,6 +134,12 @@ ThemesManager::ThemesManager(QObject *parent) : QObject(parent)
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &ThemesManager::handleOptionChanged);
 }
 
+ThemesManager::~ThemesManager()
+{
+	m_icons.clear();
+	m_dataUriIcons.clear();
+}
+
 void ThemesManager::createInstance()
 {
 	if (!m_instance)
@@ -167,6 +178,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 				{
 					m_iconThemePath = path;
 
+					m_icons.clear();
+
 					emit iconThemeChanged();
 				}
 			}
@@ -177,6 +190,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 			{
 				m_useSystemIconTheme = value.toBool();
 
+				m_icons.clear();
+
 				emit iconThemeChanged();
 			}
 
@@ -243,29 +258,70 @@ QIcon ThemesManager::createIcon(const QString &name, bool fromTheme)
 
 	if (name.startsWith(QLatin1String("data:image/")))
 	{
-		return QIcon(Utils::loadPixmapFromDataUri(name));
+		const QByteArray hash(QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Md5));
+		const QIcon *cachedIcon(m_dataUriIcons.object(hash));
+
+		if (cachedIcon)
+		{
+			++m_iconsCacheStatistics.dataUriHits;
+
+			return *cachedIcon;
+		}
+
+		++m_iconsCacheStatistics.dataUriMisses;
+
+		const QIcon icon(Utils::loadPixmapFromDataUri(name));
+
+		m_dataUriIcons.insert(hash, new QIcon(icon));
+
+		return icon;
 	}
 
-	if (m_useSystemIconTheme && fromTheme && QIcon::hasThemeIcon(name))
+	const QPair<QString, bool> key(name, fromTheme);
+
+	if (m_icons.contains(key))
 	{
-		return QIcon::fromTheme(name);
+		++m_iconsCacheStatistics.hits;
+
+		return m_icons[key];
 	}
 
-	const QString iconPath((!fromTheme && name == QLatin1String("otter-browser")) ? QLatin1String(":/icons/otter-browser") : m_iconThemePath + name);
-	const QString svgPath(iconPath + QLatin1String(".svg"));
-	const QString rasterPath(iconPath + QLatin1String(".png"));
+	++m_iconsCacheStatistics.misses;
 
-	if (QFile::exists(svgPath))
+	QIcon icon;
+
+	if (m_useSystemIconTheme && fromTheme && QIcon::hasThemeIcon(name))
 	{
-		return QIcon(svgPath);
+		icon = QIcon::fromTheme(name);
 	}
-
-	if (QFile::exists(rasterPath))
+	else
 	{
-		return QIcon(rasterPath);
+		const QString iconPath((!fromTheme && name == QLatin1String("otter-browser")) ? QLatin1String(":/icons/otter-browser") : m_iconThemePath + name);
+		const QString svgPath(iconPath + QLatin1String(".svg"));
+		const QString rasterPath(iconPath + QLatin1String(".png"));
+
+		if (QFile::exists(svgPath))
+		{
+			icon = QIcon(svgPath);
+		}
+		else if (QFile::exists(rasterPath))
+		{
+			icon = QIcon(rasterPath);
+		}
 	}
 
-	return {};
+	m_icons[key] = icon;
+
+	return icon;
+}
+
+ThemesManager::IconsCacheStatistics ThemesManager::getIconsCacheStatistics()
+{
+	IconsCacheStatistics statistics(m_iconsCacheStatistics);
+	statistics.entries = m_icons.count();
+	statistics.dataUriEntries = m_dataUriIcons.count();
+
+	return statistics;
 }
 
 bool ThemesManager::eventFilter(QObject *object, QEvent *event)
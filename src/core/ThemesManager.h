@@ -25,7 +25,9 @@
 #ifdef Q_OS_WIN32
 #include <QtCore/QAbstractNativeEventFilter>
 #endif
+#include <QtCore/QCache>
 #include <QtCore/QMap>
+#include <QtGui/QIcon>
 #include <QtWidgets/QStyle>
 
 namespace Otter
@@ -103,15 +105,27 @@ class ThemesManager final : public QObject
 	Q_OBJECT
 
 public:
+	struct IconsCacheStatistics final
+	{
+		quint64 hits = 0;
+		quint64 misses = 0;
+		quint64 dataUriHits = 0;
+		quint64 dataUriMisses = 0;
+		int entries = 0;
+		int dataUriEntries = 0;
+	};
+
 	static void createInstance();
 	static ThemesManager* getInstance();
 	static ColorScheme* getColorScheme();
 	static Style* createStyle(const QString &name);
 	static QString getAnimationPath(const QString &name);
 	static QIcon createIcon(const QString &name, bool fromTheme = true);
+	static IconsCacheStatistics getIconsCacheStatistics();
 
 protected:
 	explicit ThemesManager(QObject *parent);
+	~ThemesManager();
 
 	bool eventFilter(QObject *object, QEvent *event) override;
 #ifdef Q_OS_WIN32
@@ -126,6 +140,9 @@ private:
 	static ColorScheme *m_colorScheme;
 	static QWidget *m_probeWidget;
 	static QString m_iconThemePath;
+	static QHash<QPair<QString, bool>, QIcon> m_icons;
+	static QCache<QByteArray, QIcon> m_dataUriIcons;
+	static IconsCacheStatistics m_iconsCacheStatistics;
 	static bool m_useSystemIconTheme;
 
 signals:
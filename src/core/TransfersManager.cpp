@@ -27,9 +27,12 @@
 #include "Utils.h"
 #include "../ui/MainWindow.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QMimeDatabase>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSettings>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QTimer>
@@ -37,25 +40,50 @@
 #include <QtWidgets/QFileIconProvider>
 #include <QtWidgets/QMessageBox>
 
+#include <algorithm>
+
+#define TRANSFER_BUFFER_SIZE 1048576
+#define TRANSFER_DIGEST_BLOCK_SIZE 1048576
+#define TRANSFER_DIGEST_CATCH_UP_SIZE 4194304
+#define TRANSFER_SEGMENT_MINIMUM_SIZE 1048576
+#define TRANSFERS_JOURNAL_MINIMUM_SIZE 500
+
 namespace Otter
 {
 
 TransfersManager* TransfersManager::m_instance(nullptr);
 QVector<Transfer*> TransfersManager::m_transfers;
-QVector<Transfer*> TransfersManager::m_privateTransfers;
+QVector<TransfersManager::QueuedTransfer> TransfersManager::m_queuedTransfers;
+QVector<QPointer<Transfer> > TransfersManager::m_throttledTransfers;
+QHash<Transfer*, quint64> TransfersManager::m_identifiers;
+QSet<Transfer*> TransfersManager::m_modifiedTransfers;
+QVector<quint64> TransfersManager::m_removedTransfers;
+quint64 TransfersManager::m_transferIdentifier(0);
+qint64 TransfersManager::m_bandwidthLimit(0);
+qint64 TransfersManager::m_bandwidthTokens(0);
+int TransfersManager::m_transfersLimit(0);
+int TransfersManager::m_hostTransfersLimit(0);
+int TransfersManager::m_downloadsLimitPeriod(0);
+int TransfersManager::m_journalSize(0);
 bool TransfersManager::m_isInitilized(false);
 bool TransfersManager::m_hasRunningTransfers(false);
+bool TransfersManager::m_isPrivateMode(false);
+bool TransfersManager::m_canRememberDownloads(true);
+bool TransfersManager::m_needsCompaction(false);
 
 Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
 	m_reply(nullptr),
 	m_device(nullptr),
+	m_copyWatcher(nullptr),
 	m_speed(0),
 	m_bytesStart(0),
 	m_bytesReceivedDifference(0),
 	m_bytesReceived(0),
 	m_bytesTotal(0),
+	m_hashedBytes(0),
 	m_options(options),
 	m_state(UnknownState),
+	m_previousState(UnknownState),
 	m_updateTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
@@ -64,21 +92,25 @@ Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ?
 {
 }
 
-Transfer::Transfer(const QSettings &settings, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
+Transfer::Transfer(const QVariantMap &information, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
 	m_reply(nullptr),
 	m_device(nullptr),
-	m_source(settings.value(QLatin1String("source")).toUrl()),
-	m_target(settings.value(QLatin1String("target")).toString()),
-	m_timeStarted(settings.value(QLatin1String("timeStarted")).toDateTime()),
-	m_timeFinished(settings.value(QLatin1String("timeFinished")).toDateTime()),
-	m_mimeType(QMimeDatabase().mimeTypeForFile(m_target)),
+	m_copyWatcher(nullptr),
+	m_source(information.value(QLatin1String("source")).toUrl()),
+	m_target(information.value(QLatin1String("target")).toString()),
+	m_validator(information.value(QLatin1String("validator")).toString().toLatin1()),
+	m_timeStarted(information.value(QLatin1String("timeStarted")).toDateTime()),
+	m_timeFinished(information.value(QLatin1String("timeFinished")).toDateTime()),
+	m_mimeType(QMimeDatabase().mimeTypeForFile(m_target, QMimeDatabase::MatchExtension)),
 	m_speed(0),
 	m_bytesStart(0),
 	m_bytesReceivedDifference(0),
-	m_bytesReceived(settings.value(QLatin1String("bytesReceived")).toLongLong()),
-	m_bytesTotal(settings.value(QLatin1String("bytesTotal")).toLongLong()),
+	m_bytesReceived(information.value(QLatin1String("bytesReceived")).toLongLong()),
+	m_bytesTotal(information.value(QLatin1String("bytesTotal")).toLongLong()),
+	m_hashedBytes(0),
 	m_options(NoOption),
-	m_state((m_bytesReceived > 0 && m_bytesTotal == m_bytesReceived && QFile::exists(settings.value(QLatin1String("target")).toString())) ? FinishedState : ErrorState),
+	m_state((m_bytesReceived > 0 && m_bytesTotal == m_bytesReceived && QFile::exists(m_target)) ? FinishedState : ErrorState),
+	m_previousState(UnknownState),
 	m_updateTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
@@ -87,10 +119,49 @@ Transfer::Transfer(const QSettings &settings, QObject *parent) : QObject(parent
 {
 	m_timeStarted.setTimeSpec(Qt::UTC);
 	m_timeFinished.setTimeSpec(Qt::UTC);
+
+	m_hashes = loadHashes(information.value(QLatin1String("hashes")).toStringList());
+
+	if (m_state == FinishedState)
+	{
+		m_computedHashes = loadHashes(information.value(QLatin1String("computedHashes")).toStringList());
+	}
+
+	const QStringList segments(information.value(QLatin1String("segments")).toStringList());
+
+	if (segments.isEmpty() || m_state == FinishedState)
+	{
+		return;
+	}
+
+	m_segments.reserve(segments.count());
+
+	for (int i = 0; i < segments.count(); ++i)
+	{
+		const QStringList values(segments.at(i).split(QLatin1Char(':')));
+
+		if (values.count() != 3)
+		{
+			m_segments.clear();
+
+			return;
+		}
+
+		Segment segment;
+		segment.offset = values.at(0).toLongLong();
+		segment.end = values.at(1).toLongLong();
+		segment.bytesReceived = values.at(2).toLongLong();
+
+		m_segments.append(segment);
+	}
 }
 
 Transfer::~Transfer()
 {
+	discardTargetCopy();
+
+	qDeleteAll(m_digests);
+
 	if (m_options.testFlag(HasToOpenAfterFinishOption) && QFile::exists(m_target))
 	{
 		QFile::remove(m_target);
@@ -151,6 +222,8 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 	const QMimeDatabase mimeDatabase;
 
 	m_reply = reply;
+	m_reply->setReadBufferSize(TRANSFER_BUFFER_SIZE);
+
 	m_source = reply->request().url().adjusted(QUrl::RemovePassword | QUrl::PreferLocalFile);
 	m_mimeType = mimeDatabase.mimeTypeForName(m_reply->header(QNetworkRequest::ContentTypeHeader).toString());
 
@@ -173,7 +246,17 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 		temporaryFileName = temporaryFileName.insert(position, QLatin1String("-XXXXXX"));
 	}
 
-	m_device = new QTemporaryFile(QStandardPaths::writableLocation(QStandardPaths::TempLocation) + QDir::separator() + temporaryFileName, this);
+	const QString directTarget(target.isEmpty() ? QString() : QFileInfo(QDir::toNativeSeparators(target)).absoluteFilePath());
+
+	if (!directTarget.isEmpty() && (m_options.testFlag(CanOverwriteOption) || !QFile::exists(directTarget)))
+	{
+		m_device = new QFile(directTarget, this);
+	}
+	else
+	{
+		m_device = new QTemporaryFile(QStandardPaths::writableLocation(QStandardPaths::TempLocation) + QDir::separator() + temporaryFileName, this);
+	}
+
 	m_timeStarted = QDateTime::currentDateTimeUtc();
 	m_bytesTotal = m_reply->header(QNetworkRequest::ContentLengthHeader).toLongLong();
 
@@ -190,7 +273,7 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 		}
 	}
 
-	if (!m_device->open(QIODevice::ReadWrite))
+	if (!m_device->open(QIODevice::ReadWrite | QIODevice::Truncate))
 	{
 		m_state = ErrorState;
 
@@ -205,6 +288,8 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 	m_target = m_device->fileName();
 	m_state = (m_reply->isFinished() ? FinishedState : RunningState);
 
+	resetDigests();
+
 	handleDataAvailable();
 
 	const bool isRunning(m_state == RunningState);
@@ -214,6 +299,7 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 		connect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
 		connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
 		connect(m_reply, static_cast<void(QNetworkReply::*)(QNetworkReply::NetworkError)>(&QNetworkReply::error), this, &Transfer::handleDownloadError);
+		connect(m_reply, &QNetworkReply::metaDataChanged, this, &Transfer::handleMetaDataChanged);
 	}
 	else
 	{
@@ -299,6 +385,11 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 		setTarget(finalTarget, canOverwriteExisting);
 	}
 
+	if (m_copyWatcher)
+	{
+		return;
+	}
+
 	if (m_state == FinishedState)
 	{
 		if (m_bytesTotal <= 0 && m_bytesReceived > 0)
@@ -320,209 +411,238 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 			m_mimeType = mimeDatabase.mimeTypeForFile(m_target);
 		}
 	}
+	else
+	{
+		handleMetaDataChanged();
+	}
 }
 
-void Transfer::openTarget() const
+void Transfer::markAsQueued(const QUrl &source)
 {
-	Utils::runApplication(m_openCommand, QUrl::fromLocalFile(getTarget()));
+	m_source = source.adjusted(QUrl::RemovePassword | QUrl::PreferLocalFile);
+	m_previousState = m_state;
+	m_state = QueuedState;
+
+	emit changed();
 }
 
-void Transfer::cancel()
+void Transfer::readThrottledData()
 {
-	m_state = CancelledState;
-
 	if (m_reply)
 	{
-		m_reply->abort();
-
-		QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
-	}
-
-	if (m_device)
-	{
-		m_device->remove();
+		handleDataAvailable();
 	}
 
-	stop();
-
-	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+	for (int i = 0; i < m_segments.count(); ++i)
 	{
-		deleteLater();
+		writeSegmentData(i);
 	}
 }
 
-void Transfer::stop()
+void Transfer::startSegmentedTransfer()
 {
-	if (m_updateTimer != 0)
+	if (!m_segments.isEmpty() || !m_reply || !m_device || m_copyWatcher || m_state != RunningState || m_isSelectingPath || m_device->inherits("QTemporaryFile") || m_device->openMode().testFlag(QIODevice::Append))
 	{
-		killTimer(m_updateTimer);
-
-		m_updateTimer = 0;
+		return;
 	}
 
-	if (m_reply)
-	{
-		m_reply->abort();
+	const QString scheme(m_reply->url().scheme());
+	const QByteArray contentEncoding(m_reply->rawHeader(QByteArrayLiteral("Content-Encoding")).trimmed().toLower());
+	const qint64 bytesTotal(m_reply->header(QNetworkRequest::ContentLengthHeader).toLongLong());
 
-		QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+	if ((scheme != QLatin1String("http") && scheme != QLatin1String("https")) || m_reply->operation() != QNetworkAccessManager::GetOperation || m_validator.isEmpty() || m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200 || m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() || m_reply->rawHeader(QByteArrayLiteral("Accept-Ranges")).trimmed().toLower() != QByteArrayLiteral("bytes") || (!contentEncoding.isEmpty() && contentEncoding != QByteArrayLiteral("identity")))
+	{
+		return;
 	}
 
-	if (m_device && !m_device->inherits("QTemporaryFile"))
+	const qint64 bytesWritten(m_device->size());
+	const int amount(static_cast<int>(qMin(static_cast<qint64>(SettingsManager::getOption(SettingsManager::Browser_TransferSegmentsAmountOption).toInt()), ((bytesTotal - bytesWritten) / TRANSFER_SEGMENT_MINIMUM_SIZE))));
+
+	if (amount < 2 || !m_device->resize(bytesTotal))
 	{
-		m_device->close();
-		m_device->deleteLater();
-		m_device = nullptr;
+		return;
 	}
 
-	if (m_state == RunningState)
+	const qint64 segmentSize((bytesTotal - bytesWritten) / amount);
+
+	m_segments.reserve(amount);
+
+	for (int i = 0; i < amount; ++i)
 	{
-		m_state = ErrorState;
+		Segment segment;
+		segment.offset = ((i == 0) ? 0 : (bytesWritten + (i * segmentSize)));
+		segment.end = ((i == (amount - 1)) ? (bytesTotal - 1) : (bytesWritten + ((i + 1) * segmentSize) - 1));
 
-		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
-		{
-			deleteLater();
-		}
+		m_segments.append(segment);
 	}
 
-	m_speeds.clear();
+	disconnect(m_reply, nullptr, this, nullptr);
 
-	emit stopped();
-	emit changed();
-}
+	m_request = m_reply->request();
+	m_request.setUrl(m_reply->url());
 
-void Transfer::markAsStarted()
-{
-	m_timeStarted = QDateTime::currentDateTimeUtc();
-}
+	m_segments[0].reply = m_reply;
+	m_segments[0].bytesReceived = bytesWritten;
+	m_segments[0].isConfirmed = true;
+	m_reply = nullptr;
+	m_bytesStart = 0;
+	m_bytesReceived = bytesWritten;
+	m_bytesTotal = bytesTotal;
 
-void Transfer::markAsFinished()
-{
-	m_timeFinished = QDateTime::currentDateTimeUtc();
+	connect(m_segments[0].reply, &QNetworkReply::readyRead, this, &Transfer::handleSegmentDataAvailable);
+	connect(m_segments[0].reply, &QNetworkReply::finished, this, &Transfer::handleSegmentFinished);
+
+	for (int i = 1; i < m_segments.count(); ++i)
+	{
+		startSegment(i);
+	}
+
+	writeSegmentData(0);
 }
 
-void Transfer::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
+void Transfer::startSegment(int index)
 {
-	m_bytesReceivedDifference += (bytesReceived - (m_bytesReceived - m_bytesStart));
-	m_bytesReceived = (m_bytesStart + bytesReceived);
-	m_bytesTotal = (m_bytesStart + bytesTotal);
+	Segment &segment(m_segments[index]);
+	segment.isConfirmed = false;
+	segment.reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(createRangeRequest((segment.offset + segment.bytesReceived), segment.end));
+	segment.reply->setReadBufferSize(TRANSFER_BUFFER_SIZE);
 
-	emit progressChanged(bytesReceived, bytesTotal);
+	connect(segment.reply, &QNetworkReply::readyRead, this, &Transfer::handleSegmentDataAvailable);
+	connect(segment.reply, &QNetworkReply::finished, this, &Transfer::handleSegmentFinished);
 }
 
-void Transfer::handleDataAvailable()
+void Transfer::writeSegmentData(int index)
 {
-	if (!m_reply || !m_device)
+	Segment &segment(m_segments[index]);
+
+	if (!segment.reply || !m_device)
 	{
 		return;
 	}
 
-	if (m_state == ErrorState)
+	if (!segment.isConfirmed)
 	{
-		m_state = RunningState;
-
-		if (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid() && m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
+		if (segment.reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206 || !segment.reply->rawHeader(QByteArrayLiteral("Content-Range")).trimmed().startsWith(QStringLiteral("bytes %1-").arg(segment.offset + segment.bytesReceived).toLatin1()))
 		{
-			m_device->reset();
+			disableSegmentation();
+
+			return;
 		}
+
+		segment.isConfirmed = true;
 	}
 
-	m_device->write(m_reply->readAll());
-	m_device->seek(m_device->size());
+	const QByteArray data(segment.reply->read(TransfersManager::takeBandwidth(this, qMin(segment.reply->bytesAvailable(), (segment.end - segment.offset - segment.bytesReceived + 1)))));
 
-	if (m_state == RunningState && m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() && m_bytesTotal >= 0 && m_device->size() == m_bytesTotal)
+	if (!data.isEmpty())
 	{
-		handleDownloadFinished();
-	}
-}
+		const qint64 offset(segment.offset + segment.bytesReceived);
 
-void Transfer::handleDownloadFinished()
-{
-	if (!m_reply)
-	{
-		if (m_device && !m_device->inherits("QTemporaryFile"))
-		{
-			m_device->close();
-			m_device->deleteLater();
-			m_device = nullptr;
-		}
+		m_device->seek(offset);
+		m_device->write(data);
 
-		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
-		{
-			deleteLater();
-		}
+		segment.bytesReceived += data.size();
 
-		return;
+		updateDigests(data, offset);
+
+		m_bytesReceived += data.size();
+		m_bytesReceivedDifference += data.size();
+
+		emit progressChanged(m_bytesReceived, m_bytesTotal);
 	}
 
-	if (!m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute).isNull())
+	if ((segment.offset + segment.bytesReceived) > segment.end)
 	{
-		const QUrl url(m_source.resolved(m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl()));
+		releaseSegment(index);
 
-		if (!url.isValid() || (m_source.scheme() == QLatin1String("https") && url.scheme() == QLatin1String("http")))
+		if (m_bytesReceived >= m_bytesTotal)
 		{
-			handleDownloadError(QNetworkReply::UnknownContentError);
+			finishSegmentedTransfer();
 		}
-		else
-		{
-			m_source = url;
+	}
+	else if (segment.reply->isFinished() && segment.reply->bytesAvailable() == 0)
+	{
+		handleDownloadError((segment.reply->error() == QNetworkReply::NoError) ? QNetworkReply::UnknownContentError : segment.reply->error());
+	}
+}
 
-			restart();
-		}
+void Transfer::releaseSegment(int index)
+{
+	QNetworkReply *reply(m_segments[index].reply);
 
+	if (!reply)
+	{
 		return;
 	}
 
-	if (m_updateTimer != 0)
-	{
-		killTimer(m_updateTimer);
+	m_segments[index].reply = nullptr;
 
-		m_updateTimer = 0;
-	}
+	disconnect(reply, nullptr, this, nullptr);
 
-	if (m_reply->size() > 0)
-	{
-		m_device->write(m_reply->readAll());
-	}
+	reply->abort();
 
-	disconnect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
-	disconnect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
-	disconnect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
+	QTimer::singleShot(250, reply, &QNetworkReply::deleteLater);
+}
 
-	m_bytesReceived = (m_device ? m_device->size() : -1);
+void Transfer::disableSegmentation()
+{
+	const bool canContinue(m_segments.first().reply && !m_segments.first().reply->request().hasRawHeader(QByteArrayLiteral("Range")));
 
-	if (m_bytesTotal <= 0 && m_bytesReceived > 0)
+	for (int i = (canContinue ? 1 : 0); i < m_segments.count(); ++i)
 	{
-		m_bytesTotal = m_bytesReceived;
+		releaseSegment(i);
 	}
 
-	if (m_bytesReceived == 0 || m_bytesReceived < m_bytesTotal)
+	if (canContinue)
 	{
-		m_state = ErrorState;
+		m_segments.resize(1);
+		m_segments[0].end = (m_bytesTotal - 1);
+
+		m_bytesReceived = m_segments.first().bytesReceived;
+
+		writeSegmentData(0);
 	}
 	else
 	{
-		markAsFinished();
+		m_segments.clear();
 
-		m_state = FinishedState;
-		m_mimeType = QMimeDatabase().mimeTypeForFile(m_target);
+		restart();
 	}
+}
 
-	emit finished();
-	emit changed();
+void Transfer::finishSegmentedTransfer()
+{
+	if (m_updateTimer != 0)
+	{
+		killTimer(m_updateTimer);
 
-	if (m_device && (m_options.testFlag(HasToOpenAfterFinishOption) || !m_device->inherits("QTemporaryFile")))
+		m_updateTimer = 0;
+	}
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		releaseSegment(i);
+	}
+
+	m_segments.clear();
+
+	finalizeDigests();
+	markAsFinished();
+
+	m_state = FinishedState;
+	m_mimeType = QMimeDatabase().mimeTypeForFile(m_target);
+
+	if (m_device)
 	{
 		m_device->close();
 		m_device->deleteLater();
 		m_device = nullptr;
-
-		if (m_reply)
-		{
-			QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
-		}
 	}
 
-	if (m_state == FinishedState && m_options.testFlag(HasToOpenAfterFinishOption))
+	emit finished();
+	emit changed();
+
+	if (m_options.testFlag(HasToOpenAfterFinishOption))
 	{
 		openTarget();
 	}
@@ -533,73 +653,655 @@ void Transfer::handleDownloadFinished()
 	}
 }
 
-void Transfer::handleDownloadError(QNetworkReply::NetworkError error)
+void Transfer::startTargetCopy(const QString &target)
 {
-	Q_UNUSED(error)
+	if (m_device)
+	{
+		m_device->flush();
+	}
 
-	stop();
+	m_copyTarget = target;
+	m_copyWatcher = new QFutureWatcher<QString>(this);
+	m_copyWatcher->setFuture(QtConcurrent::run(&Transfer::copyFile, m_target, target));
 
-	m_state = ErrorState;
+	connect(m_copyWatcher, &QFutureWatcher<QString>::finished, this, &Transfer::handleTargetCopied);
+}
 
-	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+void Transfer::discardTargetCopy()
+{
+	if (!m_copyWatcher)
 	{
-		deleteLater();
+		return;
 	}
-}
 
-void Transfer::setOpenCommand(const QString &command)
-{
-	m_openCommand = command;
+	QFutureWatcher<QString> *watcher(m_copyWatcher);
 
-	m_options |= HasToOpenAfterFinishOption;
+	m_copyWatcher = nullptr;
 
-	QTemporaryFile *file(qobject_cast<QTemporaryFile*>(m_device));
+	m_copyTarget.clear();
 
-	if (file)
-	{
-		file->setAutoRemove(false);
-	}
+	watcher->disconnect(this);
+	watcher->setParent(QCoreApplication::instance());
 
-	if (m_state == FinishedState)
+	connect(watcher, &QFutureWatcher<QString>::finished, watcher, [=]()
 	{
-		if (file)
+		if (!watcher->result().isEmpty())
 		{
-			file->close();
-			file->deleteLater();
-
-			m_device = nullptr;
+			QFile::remove(watcher->result());
 		}
 
-		openTarget();
-	}
+		watcher->deleteLater();
+	});
 }
 
-void Transfer::setHash(const QByteArray &hash, QCryptographicHash::Algorithm algorithm)
+void Transfer::replaceDevice(QFile *device)
 {
-	if (!hash.isEmpty())
+	m_device->close();
+	m_device->deleteLater();
+	m_device = device;
+
+	handleDataAvailable();
+
+	if (!m_reply || m_reply->isFinished())
 	{
-		m_hashes[algorithm] = hash;
+		handleDownloadFinished();
 	}
-	else if (m_hashes.contains(algorithm))
+	else
 	{
-		m_hashes.remove(algorithm);
+		handleMetaDataChanged();
 	}
 }
 
-void Transfer::setUpdateInterval(int interval)
+void Transfer::resetDigests()
 {
-	m_updateInterval = interval;
+	qDeleteAll(m_digests);
 
-	if (m_updateTimer != 0)
-	{
-		killTimer(m_updateTimer);
+	m_digests.clear();
+	m_computedHashes.clear();
 
-		m_updateTimer = 0;
-	}
+	m_hashedBytes = 0;
 
-	if (interval > 0 && m_updateInterval > 0 && m_state == Transfer::RunningState)
+	QHash<QCryptographicHash::Algorithm, QByteArray>::const_iterator iterator;
+
+	for (iterator = m_hashes.constBegin(); iterator != m_hashes.constEnd(); ++iterator)
 	{
-		m_updateTimer = startTimer(m_updateInterval);
+		m_digests[iterator.key()] = new QCryptographicHash(iterator.key());
+	}
+}
+
+void Transfer::updateDigests(const QByteArray &data, qint64 offset)
+{
+	if (m_digests.isEmpty())
+	{
+		return;
+	}
+
+	if (offset > m_hashedBytes)
+	{
+		readDigestsData(TRANSFER_DIGEST_CATCH_UP_SIZE);
+
+		return;
+	}
+
+	if ((offset + data.size()) <= m_hashedBytes)
+	{
+		return;
+	}
+
+	const QByteArray remainingData((offset == m_hashedBytes) ? data : data.mid(static_cast<int>(m_hashedBytes - offset)));
+	QHash<QCryptographicHash::Algorithm, QCryptographicHash*>::const_iterator iterator;
+
+	for (iterator = m_digests.constBegin(); iterator != m_digests.constEnd(); ++iterator)
+	{
+		iterator.value()->addData(remainingData);
+	}
+
+	m_hashedBytes += remainingData.size();
+}
+
+void Transfer::readDigestsData(qint64 limit)
+{
+	const qint64 bytesAvailable(getContiguousBytes());
+
+	if (m_digests.isEmpty() || m_hashedBytes >= bytesAvailable)
+	{
+		return;
+	}
+
+	if (m_device)
+	{
+		m_device->flush();
+	}
+
+	QFile file(m_device ? m_device->fileName() : m_target);
+
+	if (!file.open(QIODevice::ReadOnly) || !file.seek(m_hashedBytes))
+	{
+		return;
+	}
+
+	qint64 bytesRemaining((limit < 0) ? (bytesAvailable - m_hashedBytes) : qMin(limit, (bytesAvailable - m_hashedBytes)));
+
+	while (bytesRemaining > 0)
+	{
+		const QByteArray data(file.read(qMin(bytesRemaining, static_cast<qint64>(TRANSFER_DIGEST_BLOCK_SIZE))));
+
+		if (data.isEmpty())
+		{
+			break;
+		}
+
+		QHash<QCryptographicHash::Algorithm, QCryptographicHash*>::const_iterator iterator;
+
+		for (iterator = m_digests.constBegin(); iterator != m_digests.constEnd(); ++iterator)
+		{
+			iterator.value()->addData(data);
+		}
+
+		m_hashedBytes += data.size();
+		bytesRemaining -= data.size();
+	}
+}
+
+void Transfer::finalizeDigests()
+{
+	if (m_digests.isEmpty())
+	{
+		return;
+	}
+
+	readDigestsData(-1);
+
+	if (m_hashedBytes == m_bytesReceived)
+	{
+		QHash<QCryptographicHash::Algorithm, QCryptographicHash*>::const_iterator iterator;
+
+		for (iterator = m_digests.constBegin(); iterator != m_digests.constEnd(); ++iterator)
+		{
+			m_computedHashes[iterator.key()] = iterator.value()->result();
+		}
+	}
+
+	qDeleteAll(m_digests);
+
+	m_digests.clear();
+}
+
+void Transfer::openTarget() const
+{
+	Utils::runApplication(m_openCommand, QUrl::fromLocalFile(getTarget()));
+}
+
+void Transfer::cancel()
+{
+	discardTargetCopy();
+
+	m_state = CancelledState;
+
+	if (m_reply)
+	{
+		m_reply->abort();
+
+		QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+	}
+
+	if (m_device)
+	{
+		m_device->remove();
+	}
+
+	stop();
+
+	m_segments.clear();
+
+	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+	{
+		deleteLater();
+	}
+}
+
+void Transfer::stop()
+{
+	if (m_state == QueuedState)
+	{
+		m_state = ((m_previousState == UnknownState) ? CancelledState : m_previousState);
+	}
+
+	if (m_updateTimer != 0)
+	{
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+	}
+
+	if (m_reply)
+	{
+		m_reply->abort();
+
+		QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+	}
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		releaseSegment(i);
+	}
+
+	if (m_device && !m_device->inherits("QTemporaryFile"))
+	{
+		m_device->close();
+		m_device->deleteLater();
+		m_device = nullptr;
+	}
+
+	if (m_state == RunningState)
+	{
+		m_state = ErrorState;
+
+		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+		{
+			deleteLater();
+		}
+	}
+
+	m_speeds.clear();
+
+	emit stopped();
+	emit changed();
+}
+
+void Transfer::markAsStarted()
+{
+	m_timeStarted = QDateTime::currentDateTimeUtc();
+}
+
+void Transfer::markAsFinished()
+{
+	m_timeFinished = QDateTime::currentDateTimeUtc();
+}
+
+void Transfer::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
+{
+	m_bytesReceivedDifference += (bytesReceived - (m_bytesReceived - m_bytesStart));
+	m_bytesReceived = (m_bytesStart + bytesReceived);
+	m_bytesTotal = (m_bytesStart + bytesTotal);
+
+	emit progressChanged(bytesReceived, bytesTotal);
+}
+
+void Transfer::handleDataAvailable()
+{
+	if (!m_reply || !m_device)
+	{
+		return;
+	}
+
+	if (m_bytesStart > 0 && m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid() && m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
+	{
+		disconnect(m_reply, nullptr, this, nullptr);
+
+		QTimer::singleShot(0, this, &Transfer::restart);
+
+		return;
+	}
+
+	if (m_state == ErrorState)
+	{
+		m_state = RunningState;
+
+		if (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid() && m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
+		{
+			m_device->resize(0);
+			m_device->reset();
+
+			resetDigests();
+		}
+	}
+
+	while (m_reply->bytesAvailable() > 0)
+	{
+		const qint64 size(TransfersManager::takeBandwidth(this, qMin(m_reply->bytesAvailable(), static_cast<qint64>(TRANSFER_BUFFER_SIZE))));
+
+		if (size <= 0)
+		{
+			break;
+		}
+
+		const QByteArray data(m_reply->read(size));
+		const qint64 offset(m_device->pos());
+
+		if (data.isEmpty())
+		{
+			break;
+		}
+
+		m_device->write(data);
+
+		updateDigests(data, offset);
+	}
+
+	if (m_state == RunningState && m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() && m_bytesTotal >= 0 && m_device->size() == m_bytesTotal)
+	{
+		handleDownloadFinished();
+	}
+}
+
+void Transfer::handleDownloadFinished()
+{
+	if (m_copyWatcher)
+	{
+		return;
+	}
+
+	if (!m_reply)
+	{
+		if (m_device && !m_device->inherits("QTemporaryFile"))
+		{
+			m_device->close();
+			m_device->deleteLater();
+			m_device = nullptr;
+		}
+
+		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+		{
+			deleteLater();
+		}
+
+		return;
+	}
+
+	if (!m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute).isNull())
+	{
+		const QUrl url(m_source.resolved(m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl()));
+
+		if (!url.isValid() || (m_source.scheme() == QLatin1String("https") && url.scheme() == QLatin1String("http")))
+		{
+			handleDownloadError(QNetworkReply::UnknownContentError);
+		}
+		else
+		{
+			m_source = url;
+
+			restart();
+		}
+
+		return;
+	}
+
+	if (m_updateTimer != 0)
+	{
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+	}
+
+	while (m_device && m_reply->bytesAvailable() > 0)
+	{
+		const QByteArray data(m_reply->read(TRANSFER_BUFFER_SIZE));
+		const qint64 offset(m_device->pos());
+
+		if (data.isEmpty())
+		{
+			break;
+		}
+
+		m_device->write(data);
+
+		updateDigests(data, offset);
+	}
+
+	disconnect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
+	disconnect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
+	disconnect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
+
+	m_bytesReceived = (m_device ? m_device->size() : -1);
+
+	if (m_bytesTotal <= 0 && m_bytesReceived > 0)
+	{
+		m_bytesTotal = m_bytesReceived;
+	}
+
+	if (m_bytesReceived == 0 || m_bytesReceived < m_bytesTotal)
+	{
+		m_state = ErrorState;
+	}
+	else
+	{
+		finalizeDigests();
+		markAsFinished();
+
+		m_state = FinishedState;
+		m_mimeType = QMimeDatabase().mimeTypeForFile(m_target);
+	}
+
+	emit finished();
+	emit changed();
+
+	if (m_device && (m_options.testFlag(HasToOpenAfterFinishOption) || !m_device->inherits("QTemporaryFile")))
+	{
+		m_device->close();
+		m_device->deleteLater();
+		m_device = nullptr;
+
+		if (m_reply)
+		{
+			QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+		}
+	}
+
+	if (m_state == FinishedState && m_options.testFlag(HasToOpenAfterFinishOption))
+	{
+		openTarget();
+	}
+
+	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+	{
+		deleteLater();
+	}
+}
+
+void Transfer::handleDownloadError(QNetworkReply::NetworkError error)
+{
+	Q_UNUSED(error)
+
+	stop();
+
+	m_state = ErrorState;
+
+	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+	{
+		deleteLater();
+	}
+}
+
+void Transfer::handleMetaDataChanged()
+{
+	if (m_reply && m_validator.isEmpty())
+	{
+		m_validator = getValidator(m_reply);
+	}
+
+	startSegmentedTransfer();
+}
+
+void Transfer::handleSegmentDataAvailable()
+{
+	const int index(getSegment(qobject_cast<QNetworkReply*>(sender())));
+
+	if (index >= 0)
+	{
+		writeSegmentData(index);
+	}
+}
+
+void Transfer::handleSegmentFinished()
+{
+	const int index(getSegment(qobject_cast<QNetworkReply*>(sender())));
+
+	if (index >= 0)
+	{
+		writeSegmentData(index);
+	}
+}
+
+void Transfer::handleTargetCopied()
+{
+	if (!m_copyWatcher)
+	{
+		return;
+	}
+
+	const QString path(m_copyWatcher->result());
+	const QString target(m_copyTarget);
+
+	m_copyWatcher->deleteLater();
+	m_copyWatcher = nullptr;
+
+	m_copyTarget.clear();
+
+	QFile *file(new QFile(path, this));
+	bool isSuccess(!path.isEmpty());
+
+	if (isSuccess)
+	{
+		if (m_device)
+		{
+			m_device->flush();
+		}
+
+		QFile source(m_target);
+
+		isSuccess = (source.open(QIODevice::ReadOnly) && source.size() >= file->size() && source.seek(file->size()) && file->open(QIODevice::WriteOnly | QIODevice::Append));
+
+		while (isSuccess && !source.atEnd())
+		{
+			const QByteArray data(source.read(TRANSFER_BUFFER_SIZE));
+
+			isSuccess = (!data.isEmpty() && file->write(data) == data.size());
+		}
+
+		file->close();
+	}
+
+	if (!isSuccess || !moveFile(path, target))
+	{
+		file->remove();
+		file->deleteLater();
+
+		if (m_reply && m_reply->isFinished())
+		{
+			handleDownloadFinished();
+		}
+		else if (m_state == RunningState)
+		{
+			handleDownloadError(QNetworkReply::UnknownContentError);
+		}
+
+		return;
+	}
+
+	const QString previousTarget(m_target);
+
+	m_target = target;
+
+	file->setFileName(target);
+
+	if (!m_device)
+	{
+		file->deleteLater();
+
+		QFile::remove(previousTarget);
+
+		emit changed();
+
+		return;
+	}
+
+	m_device->close();
+
+	QFile::remove(previousTarget);
+
+	if (!file->open(QIODevice::ReadWrite) || !file->seek(file->size()))
+	{
+		file->deleteLater();
+
+		m_device->deleteLater();
+		m_device = nullptr;
+
+		handleDownloadError(QNetworkReply::UnknownContentError);
+
+		return;
+	}
+
+	replaceDevice(file);
+}
+
+void Transfer::setOpenCommand(const QString &command)
+{
+	m_openCommand = command;
+
+	m_options |= HasToOpenAfterFinishOption;
+
+	QTemporaryFile *file(qobject_cast<QTemporaryFile*>(m_device));
+
+	if (file)
+	{
+		file->setAutoRemove(false);
+	}
+
+	if (m_state == FinishedState)
+	{
+		if (file)
+		{
+			file->close();
+			file->deleteLater();
+
+			m_device = nullptr;
+		}
+
+		openTarget();
+	}
+}
+
+void Transfer::setHash(const QByteArray &hash, QCryptographicHash::Algorithm algorithm)
+{
+	if (!hash.isEmpty())
+	{
+		m_hashes[algorithm] = hash;
+	}
+	else if (m_hashes.contains(algorithm))
+	{
+		m_hashes.remove(algorithm);
+	}
+
+	if (m_state != RunningState)
+	{
+		return;
+	}
+
+	if (hash.isEmpty())
+	{
+		delete m_digests.take(algorithm);
+	}
+	else if (!m_digests.contains(algorithm))
+	{
+		resetDigests();
+	}
+}
+
+void Transfer::setUpdateInterval(int interval)
+{
+	m_updateInterval = interval;
+
+	if (m_updateTimer != 0)
+	{
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+	}
+
+	if (interval > 0 && m_updateInterval > 0 && m_state == Transfer::RunningState)
+	{
+		m_updateTimer = startTimer(m_updateInterval);
 	}
 }
 
@@ -721,46 +1423,267 @@ Transfer::TransferState Transfer::getState() const
 	return m_state;
 }
 
-int Transfer::getRemainingTime() const
-{
-	return m_remainingTime;
-}
+int Transfer::getRemainingTime() const
+{
+	return m_remainingTime;
+}
+
+QNetworkRequest Transfer::createRangeRequest(qint64 offset, qint64 end) const
+{
+	QNetworkRequest request(m_request);
+
+	if (request.url().isEmpty())
+	{
+		request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
+		request.setUrl(m_source);
+	}
+
+	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+	request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+	request.setRawHeader(QByteArrayLiteral("Accept-Encoding"), QByteArrayLiteral("identity"));
+	request.setRawHeader(QByteArrayLiteral("Range"), ((end < 0) ? QStringLiteral("bytes=%1-").arg(offset) : QStringLiteral("bytes=%1-%2").arg(offset).arg(end)).toLatin1());
+
+	if (!m_validator.isEmpty())
+	{
+		request.setRawHeader(QByteArrayLiteral("If-Range"), m_validator);
+	}
+
+	return request;
+}
+
+QStringList Transfer::getSegmentsState() const
+{
+	QStringList segments;
+	segments.reserve(m_segments.count());
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		const Segment &segment(m_segments.at(i));
+
+		segments.append(QStringLiteral("%1:%2:%3").arg(segment.offset).arg(segment.end).arg(segment.bytesReceived));
+	}
+
+	return segments;
+}
+
+qint64 Transfer::getContiguousBytes() const
+{
+	if (m_segments.isEmpty())
+	{
+		return (m_device ? m_device->size() : m_bytesReceived);
+	}
+
+	qint64 bytes(0);
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		const Segment &segment(m_segments.at(i));
+
+		if (segment.offset > bytes)
+		{
+			break;
+		}
+
+		bytes = qMax(bytes, (segment.offset + segment.bytesReceived));
+
+		if ((segment.offset + segment.bytesReceived) <= segment.end)
+		{
+			break;
+		}
+	}
+
+	return bytes;
+}
+
+int Transfer::getSegment(QNetworkReply *reply) const
+{
+	if (!reply)
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		if (m_segments.at(i).reply == reply)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+QString Transfer::copyFile(const QString &source, const QString &target)
+{
+	QFile sourceFile(source);
+	QTemporaryFile targetFile(target + QLatin1String(".XXXXXX"));
+	targetFile.setAutoRemove(false);
+
+	if (!sourceFile.open(QIODevice::ReadOnly) || !targetFile.open())
+	{
+		return {};
+	}
+
+	while (!sourceFile.atEnd())
+	{
+		const QByteArray data(sourceFile.read(TRANSFER_BUFFER_SIZE));
+
+		if (data.isEmpty() || targetFile.write(data) != data.size())
+		{
+			targetFile.remove();
+
+			return {};
+		}
+	}
+
+	targetFile.close();
+
+	return targetFile.fileName();
+}
+
+QByteArray Transfer::getValidator(QNetworkReply *reply)
+{
+	const QByteArray entityTag(reply->rawHeader(QByteArrayLiteral("ETag")).trimmed());
+
+	if (!entityTag.isEmpty() && !entityTag.startsWith(QByteArrayLiteral("W/")))
+	{
+		return entityTag;
+	}
+
+	return reply->rawHeader(QByteArrayLiteral("Last-Modified")).trimmed();
+}
+
+QHash<QCryptographicHash::Algorithm, QByteArray> Transfer::loadHashes(const QStringList &hashes)
+{
+	QHash<QCryptographicHash::Algorithm, QByteArray> result;
+
+	for (int i = 0; i < hashes.count(); ++i)
+	{
+		const int separator(hashes.at(i).indexOf(QLatin1Char(':')));
+
+		if (separator > 0)
+		{
+			result[static_cast<QCryptographicHash::Algorithm>(hashes.at(i).left(separator).toInt())] = QByteArray::fromHex(hashes.at(i).mid(separator + 1).toLatin1());
+		}
+	}
+
+	return result;
+}
+
+QStringList Transfer::saveHashes(const QHash<QCryptographicHash::Algorithm, QByteArray> &hashes)
+{
+	QStringList result;
+	result.reserve(hashes.count());
+
+	QHash<QCryptographicHash::Algorithm, QByteArray>::const_iterator iterator;
+
+	for (iterator = hashes.constBegin(); iterator != hashes.constEnd(); ++iterator)
+	{
+		result.append(QString::number(iterator.key()) + QLatin1Char(':') + QString::fromLatin1(iterator.value().toHex()));
+	}
+
+	return result;
+}
+
+bool Transfer::moveFile(const QString &source, const QString &target)
+{
+	if (!QFile::exists(target))
+	{
+		return QDir().rename(source, target);
+	}
+
+	QString backupPath(target + QLatin1String(".bak"));
+
+	for (int i = 1; QFile::exists(backupPath); ++i)
+	{
+		backupPath = target + QStringLiteral(".bak%1").arg(i);
+	}
+
+	if (!QDir().rename(target, backupPath))
+	{
+		return false;
+	}
+
+	if (!QDir().rename(source, target))
+	{
+		QDir().rename(backupPath, target);
+
+		return false;
+	}
+
+	QFile::remove(backupPath);
+
+	return true;
+}
+
+bool Transfer::verifyHashes() const
+{
+	if (getState() != FinishedState)
+	{
+		return false;
+	}
+
+	QHash<QCryptographicHash::Algorithm, QByteArray> computedHashes(m_computedHashes);
+	QHash<QCryptographicHash::Algorithm, QCryptographicHash*> digests;
+	QHash<QCryptographicHash::Algorithm, QByteArray>::const_iterator iterator;
+
+	for (iterator = m_hashes.constBegin(); iterator != m_hashes.constEnd(); ++iterator)
+	{
+		if (!computedHashes.contains(iterator.key()))
+		{
+			digests[iterator.key()] = new QCryptographicHash(iterator.key());
+		}
+	}
+
+	if (!digests.isEmpty())
+	{
+		QFile file(getTarget());
+
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			qDeleteAll(digests);
+
+			return false;
+		}
+
+		while (!file.atEnd())
+		{
+			const QByteArray data(file.read(TRANSFER_DIGEST_BLOCK_SIZE));
+
+			if (data.isEmpty())
+			{
+				break;
+			}
+
+			QHash<QCryptographicHash::Algorithm, QCryptographicHash*>::const_iterator digestsIterator;
+
+			for (digestsIterator = digests.constBegin(); digestsIterator != digests.constEnd(); ++digestsIterator)
+			{
+				digestsIterator.value()->addData(data);
+			}
+		}
+
+		file.close();
 
-bool Transfer::verifyHashes() const
-{
-	if (getState() != FinishedState)
-	{
-		return false;
-	}
+		QHash<QCryptographicHash::Algorithm, QCryptographicHash*>::const_iterator digestsIterator;
 
-	QFile file(getTarget());
+		for (digestsIterator = digests.constBegin(); digestsIterator != digests.constEnd(); ++digestsIterator)
+		{
+			computedHashes[digestsIterator.key()] = digestsIterator.value()->result();
+		}
 
-	if (!file.open(QIODevice::ReadOnly))
-	{
-		return false;
+		qDeleteAll(digests);
 	}
 
-	QHash<QCryptographicHash::Algorithm, QByteArray>::const_iterator iterator;
-	bool isValid(true);
-
 	for (iterator = m_hashes.constBegin(); iterator != m_hashes.constEnd(); ++iterator)
 	{
-		QCryptographicHash hash(iterator.key());
-		hash.addData(&file);
-
-		if (hash.result() != iterator.value())
+		if (computedHashes.value(iterator.key()) != iterator.value())
 		{
-			isValid = false;
-
-			break;
+			return false;
 		}
-
-		file.seek(0);
 	}
 
-	file.close();
-
-	return isValid;
+	return true;
 }
 
 bool Transfer::isArchived() const
@@ -770,7 +1693,7 @@ bool Transfer::isArchived() const
 
 bool Transfer::resume()
 {
-	if (m_state != ErrorState || !QFile::exists(m_target))
+	if ((m_state != ErrorState && m_state != QueuedState) || !QFile::exists(m_target))
 	{
 		return false;
 	}
@@ -782,6 +1705,50 @@ bool Transfer::resume()
 		return restart();
 	}
 
+	if (m_digests.count() != m_hashes.count())
+	{
+		resetDigests();
+	}
+
+	if (!m_segments.isEmpty())
+	{
+		QFile *file(new QFile(m_target));
+
+		if (!file->open(QIODevice::ReadWrite) || (file->size() != m_bytesTotal && !file->resize(m_bytesTotal)))
+		{
+			file->deleteLater();
+
+			return false;
+		}
+
+		m_state = RunningState;
+		m_device = file;
+		m_timeStarted = QDateTime::currentDateTimeUtc();
+		m_timeFinished = {};
+		m_bytesStart = 0;
+		m_bytesReceived = 0;
+
+		for (int i = 0; i < m_segments.count(); ++i)
+		{
+			m_bytesReceived += m_segments.at(i).bytesReceived;
+		}
+
+		for (int i = 0; i < m_segments.count(); ++i)
+		{
+			if ((m_segments.at(i).offset + m_segments.at(i).bytesReceived) <= m_segments.at(i).end)
+			{
+				startSegment(i);
+			}
+		}
+
+		if (m_updateTimer == 0 && m_updateInterval > 0)
+		{
+			m_updateTimer = startTimer(m_updateInterval);
+		}
+
+		return true;
+	}
+
 	QFile *file(new QFile(m_target));
 
 	if (!file->open(QIODevice::WriteOnly | QIODevice::Append))
@@ -796,14 +1763,8 @@ bool Transfer::resume()
 	m_timeStarted = QDateTime::currentDateTimeUtc();
 	m_timeFinished = {};
 	m_bytesStart = file->size();
-
-	QNetworkRequest request;
-	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
-	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
-	request.setRawHeader(QByteArrayLiteral("Range"), QStringLiteral("bytes=%1-").arg(file->size()).toLatin1());
-	request.setUrl(m_source);
-
-	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request);
+	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(createRangeRequest(file->size()));
+	m_reply->setReadBufferSize(TRANSFER_BUFFER_SIZE);
 
 	handleDataAvailable();
 
@@ -822,8 +1783,21 @@ bool Transfer::resume()
 
 bool Transfer::restart()
 {
+	if (m_copyWatcher)
+	{
+		m_target = m_copyTarget;
+
+		discardTargetCopy();
+	}
+
 	stop();
 
+	m_segments.clear();
+
+	resetDigests();
+
+	m_validator.clear();
+
 	m_isArchived = false;
 
 	QFile *file(new QFile(m_target));
@@ -847,6 +1821,7 @@ bool Transfer::restart()
 	request.setUrl(m_source);
 
 	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request);
+	m_reply->setReadBufferSize(TRANSFER_BUFFER_SIZE);
 
 	handleDataAvailable();
 
@@ -854,6 +1829,7 @@ bool Transfer::restart()
 	connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
 	connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
 	connect(m_reply, static_cast<void(QNetworkReply::*)(QNetworkReply::NetworkError)>(&QNetworkReply::error), this, &Transfer::handleDownloadError);
+	connect(m_reply, &QNetworkReply::metaDataChanged, this, &Transfer::handleMetaDataChanged);
 
 	if (m_updateTimer == 0 && m_updateInterval > 0)
 	{
@@ -865,7 +1841,7 @@ bool Transfer::restart()
 
 bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
 {
-	if (m_target == target)
+	if (m_target == target || m_copyWatcher)
 	{
 		return false;
 	}
@@ -905,68 +1881,85 @@ bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
 			return false;
 		}
 
-		const bool isSuccess(QFile::rename(m_target, mutableTarget));
-
-		if (isSuccess)
+		if (moveFile(m_target, mutableTarget))
 		{
 			m_target = mutableTarget;
+
+			return true;
 		}
 
-		return isSuccess;
-	}
+		startTargetCopy(mutableTarget);
 
-	QFile *file(new QFile(mutableTarget, this));
+		return false;
+	}
 
-	if (!file->open(QIODevice::WriteOnly))
+	if (!m_segments.isEmpty())
 	{
-		m_state = ErrorState;
-
-		file->deleteLater();
+		return false;
+	}
 
-		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
-		{
-			deleteLater();
-		}
+	QTemporaryFile *temporaryFile(qobject_cast<QTemporaryFile*>(m_device));
 
-		return false;
+	if (temporaryFile)
+	{
+		temporaryFile->setAutoRemove(false);
 	}
 
-	m_target = mutableTarget;
+	m_device->close();
 
-	if (m_device)
+	if (!moveFile(m_target, mutableTarget))
 	{
-		if (m_reply && m_state == RunningState)
+		if (temporaryFile)
 		{
-			disconnect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
+			temporaryFile->setAutoRemove(true);
 		}
 
-		m_device->reset();
+		if (!m_device->open(QIODevice::ReadWrite) || !m_device->seek(m_device->size()))
+		{
+			handleDownloadError(QNetworkReply::UnknownContentError);
+
+			return false;
+		}
 
-		file->write(m_device->readAll());
+		startTargetCopy(mutableTarget);
 
-		m_device->close();
-		m_device->deleteLater();
+		return false;
 	}
 
-	m_device = file;
+	m_target = mutableTarget;
 
-	handleDataAvailable();
+	QFile *file(new QFile(mutableTarget, this));
 
-	if (!m_reply || m_reply->isFinished())
-	{
-		handleDownloadFinished();
-	}
-	else
+	if (!file->open(QIODevice::ReadWrite) || !file->seek(file->size()))
 	{
-		connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
+		file->deleteLater();
+
+		m_device->deleteLater();
+		m_device = nullptr;
+
+		handleDownloadError(QNetworkReply::UnknownContentError);
+
+		return false;
 	}
 
+	replaceDevice(file);
+
 	return false;
 }
 
 TransfersManager::TransfersManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+	m_saveTimer(0),
+	m_bandwidthTimer(0)
 {
+	handleOptionChanged(SettingsManager::Browser_TransfersBandwidthLimitOption, SettingsManager::getOption(SettingsManager::Browser_TransfersBandwidthLimitOption));
+	handleOptionChanged(SettingsManager::Browser_TransfersLimitOption, SettingsManager::getOption(SettingsManager::Browser_TransfersLimitOption));
+	handleOptionChanged(SettingsManager::Browser_TransfersPerHostLimitOption, SettingsManager::getOption(SettingsManager::Browser_TransfersPerHostLimitOption));
+	handleOptionChanged(SettingsManager::Browser_PrivateModeOption, SettingsManager::getOption(SettingsManager::Browser_PrivateModeOption));
+	handleOptionChanged(SettingsManager::History_DownloadsLimitPeriodOption, SettingsManager::getOption(SettingsManager::History_DownloadsLimitPeriodOption));
+	handleOptionChanged(SettingsManager::History_RememberDownloadsOption, SettingsManager::getOption(SettingsManager::History_RememberDownloadsOption));
+
+	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &TransfersManager::handleOptionChanged);
+	connect(QCoreApplication::instance(), &Application::aboutToQuit, this, &TransfersManager::save);
 }
 
 void TransfersManager::createInstance()
@@ -987,6 +1980,46 @@ void TransfersManager::timerEvent(QTimerEvent *event)
 
 		save();
 	}
+	else if (event->timerId() == m_bandwidthTimer)
+	{
+		m_bandwidthTokens = qMin(m_bandwidthLimit, (m_bandwidthTokens + (m_bandwidthLimit / 10)));
+
+		if (m_throttledTransfers.isEmpty())
+		{
+			if (m_bandwidthTokens >= m_bandwidthLimit)
+			{
+				killTimer(m_bandwidthTimer);
+
+				m_bandwidthTimer = 0;
+			}
+
+			return;
+		}
+
+		const QVector<QPointer<Transfer> > transfers(m_throttledTransfers);
+
+		m_throttledTransfers.clear();
+
+		for (int i = 0; i < transfers.count(); ++i)
+		{
+			const int index((i + 1) % transfers.count());
+
+			if (transfers.at(index) && transfers.at(index)->getState() == Transfer::RunningState)
+			{
+				transfers.at(index)->readThrottledData();
+			}
+		}
+	}
+}
+
+void TransfersManager::markAsModified(Transfer *transfer)
+{
+	if (m_identifiers.contains(transfer))
+	{
+		m_modifiedTransfers.insert(transfer);
+
+		scheduleSave();
+	}
 }
 
 void TransfersManager::scheduleSave()
@@ -1041,11 +2074,7 @@ void TransfersManager::addTransfer(Transfer *transfer)
 		}
 	}
 
-	if (transfer->getOptions().testFlag(Transfer::IsPrivateOption))
-	{
-		m_privateTransfers.append(transfer);
-	}
-	else
+	if (!transfer->getOptions().testFlag(Transfer::IsPrivateOption) && !m_identifiers.contains(transfer))
 	{
 		const QString scheme(transfer->getSource().scheme());
 
@@ -1053,50 +2082,240 @@ void TransfersManager::addTransfer(Transfer *transfer)
 		{
 			HistoryManager::addEntry(transfer->getSource());
 		}
+
+		m_transferIdentifier = qMax((m_transferIdentifier + 1), static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()));
+
+		m_identifiers[transfer] = m_transferIdentifier;
+
+		m_instance->markAsModified(transfer);
+	}
+}
+
+void TransfersManager::scheduleTransfers()
+{
+	if (m_queuedTransfers.isEmpty())
+	{
+		return;
+	}
+
+	QHash<QString, int> hostTransfers;
+	int activeTransfers(0);
+
+	for (int i = 0; i < m_transfers.count(); ++i)
+	{
+		if (m_transfers.at(i)->getState() == Transfer::RunningState)
+		{
+			++activeTransfers;
+			++hostTransfers[m_transfers.at(i)->getSource().host()];
+		}
+	}
+
+	int i(0);
+
+	while (i < m_queuedTransfers.count() && (m_transfersLimit <= 0 || activeTransfers < m_transfersLimit))
+	{
+		if (!m_queuedTransfers.at(i).transfer || m_queuedTransfers.at(i).transfer->getState() != Transfer::QueuedState)
+		{
+			m_queuedTransfers.removeAt(i);
+
+			continue;
+		}
+
+		const QString host(m_queuedTransfers.at(i).request.url().host());
+
+		if (m_hostTransfersLimit > 0 && hostTransfers.value(host) >= m_hostTransfersLimit)
+		{
+			++i;
+
+			continue;
+		}
+
+		++activeTransfers;
+		++hostTransfers[host];
+
+		startQueuedTransfer(m_queuedTransfers.at(i).transfer);
 	}
 }
 
 void TransfersManager::save()
 {
-	if (SessionsManager::isReadOnly() || SettingsManager::getOption(SettingsManager::Browser_PrivateModeOption).toBool() || !SettingsManager::getOption(SettingsManager::History_RememberDownloadsOption).toBool())
+	if (SessionsManager::isReadOnly() || m_isPrivateMode || !m_canRememberDownloads)
+	{
+		m_modifiedTransfers.clear();
+		m_removedTransfers.clear();
+
+		return;
+	}
+
+	if (m_needsCompaction || (m_journalSize + m_modifiedTransfers.count() + m_removedTransfers.count()) > qMax(TRANSFERS_JOURNAL_MINIMUM_SIZE, (m_transfers.count() * 2)))
+	{
+		compact();
+
+		return;
+	}
+
+	if (m_modifiedTransfers.isEmpty() && m_removedTransfers.isEmpty())
+	{
+		return;
+	}
+
+	QFile file(getJournalPath());
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
 	{
 		return;
 	}
 
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_6);
+
+	int amount(0);
+
+	for (int i = 0; i < m_removedTransfers.count(); ++i)
+	{
+		stream << static_cast<quint8>(RemoveTransfer) << m_removedTransfers.at(i);
+
+		++amount;
+	}
+
+	QSet<Transfer*>::const_iterator iterator;
+
+	for (iterator = m_modifiedTransfers.constBegin(); iterator != m_modifiedTransfers.constEnd(); ++iterator)
+	{
+		if (m_identifiers.contains(*iterator) && ((*iterator)->getState() != Transfer::QueuedState || !(*iterator)->getTarget().isEmpty()))
+		{
+			stream << static_cast<quint8>(UpdateTransfer) << m_identifiers.value(*iterator) << createRecord(*iterator);
+
+			++amount;
+		}
+	}
+
+	file.close();
+
+	if (stream.status() == QDataStream::Ok && file.error() == QFileDevice::NoError)
+	{
+		m_journalSize += amount;
+
+		m_modifiedTransfers.clear();
+		m_removedTransfers.clear();
+	}
+	else
+	{
+		m_needsCompaction = true;
+	}
+}
+
+void TransfersManager::compact()
+{
+	if (!m_isInitilized)
+	{
+		getTransfers();
+	}
+
 	QSettings history(SessionsManager::getWritableDataPath(QLatin1String("transfers.ini")), QSettings::IniFormat);
 	history.clear();
 
-	const int limit(SettingsManager::getOption(SettingsManager::History_DownloadsLimitPeriodOption).toInt());
-	int entry(1);
+	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
 
 	for (int i = 0; i < m_transfers.count(); ++i)
 	{
-		if (m_privateTransfers.contains(m_transfers.at(i)) || (m_transfers.at(i)->getState() == Transfer::FinishedState && m_transfers.at(i)->getTimeFinished().isValid() && m_transfers.at(i)->getTimeFinished().daysTo(QDateTime::currentDateTimeUtc()) > limit))
+		Transfer *transfer(m_transfers.at(i));
+
+		if (!m_identifiers.contains(transfer) || (transfer->getState() == Transfer::QueuedState && transfer->getTarget().isEmpty()) || (transfer->getState() == Transfer::FinishedState && transfer->getTimeFinished().isValid() && transfer->getTimeFinished().daysTo(currentDateTime) > m_downloadsLimitPeriod))
 		{
 			continue;
 		}
 
-		history.setValue(QStringLiteral("%1/source").arg(entry), m_transfers.at(i)->getSource().toString());
-		history.setValue(QStringLiteral("%1/target").arg(entry), m_transfers.at(i)->getTarget());
-		history.setValue(QStringLiteral("%1/timeStarted").arg(entry), m_transfers.at(i)->getTimeStarted().toString(Qt::ISODate));
-		history.setValue(QStringLiteral("%1/timeFinished").arg(entry), ((m_transfers.at(i)->getTimeFinished().isValid() && m_transfers.at(i)->getState() != Transfer::RunningState) ? m_transfers.at(i)->getTimeFinished() : QDateTime::currentDateTimeUtc()).toString(Qt::ISODate));
-		history.setValue(QStringLiteral("%1/bytesTotal").arg(entry), m_transfers.at(i)->getBytesTotal());
-		history.setValue(QStringLiteral("%1/bytesReceived").arg(entry), m_transfers.at(i)->getBytesReceived());
+		const QVariantMap record(createRecord(transfer));
+		QVariantMap::const_iterator iterator;
+
+		history.beginGroup(QString::number(m_identifiers.value(transfer)));
+
+		for (iterator = record.constBegin(); iterator != record.constEnd(); ++iterator)
+		{
+			history.setValue(iterator.key(), iterator.value());
+		}
+
+		history.endGroup();
+	}
+
+	history.sync();
+
+	if (history.status() != QSettings::NoError)
+	{
+		return;
+	}
+
+	QFile::remove(getJournalPath());
+
+	m_journalSize = 0;
+	m_needsCompaction = false;
+
+	m_modifiedTransfers.clear();
+	m_removedTransfers.clear();
+}
+
+void TransfersManager::clearTransfers(int period)
+{
+	for (int i = (m_transfers.count() - 1); i >= 0; --i)
+	{
+		if (m_transfers.at(i)->getState() == Transfer::FinishedState && (period == 0 || (m_transfers.at(i)->getTimeFinished().isValid() && m_transfers.at(i)->getTimeFinished().secsTo(QDateTime::currentDateTimeUtc()) > (period * 3600))))
+		{
+			TransfersManager::removeTransfer(m_transfers.at(i));
+		}
+	}
+}
+
+void TransfersManager::handleOptionChanged(int identifier, const QVariant &value)
+{
+	switch (identifier)
+	{
+		case SettingsManager::Browser_TransfersBandwidthLimitOption:
+			m_bandwidthLimit = (qMax(0, value.toInt()) * 1024);
+			m_bandwidthTokens = m_bandwidthLimit;
+
+			if (m_bandwidthLimit == 0 && !m_throttledTransfers.isEmpty())
+			{
+				const QVector<QPointer<Transfer> > transfers(m_throttledTransfers);
+
+				m_throttledTransfers.clear();
+
+				for (int i = 0; i < transfers.count(); ++i)
+				{
+					if (transfers.at(i) && transfers.at(i)->getState() == Transfer::RunningState)
+					{
+						transfers.at(i)->readThrottledData();
+					}
+				}
+			}
+
+			break;
+		case SettingsManager::Browser_TransfersLimitOption:
+			m_transfersLimit = value.toInt();
+
+			QTimer::singleShot(0, this, &TransfersManager::scheduleTransfers);
+
+			break;
+		case SettingsManager::Browser_TransfersPerHostLimitOption:
+			m_hostTransfersLimit = value.toInt();
 
-		++entry;
-	}
+			QTimer::singleShot(0, this, &TransfersManager::scheduleTransfers);
 
-	history.sync();
-}
+			break;
+		case SettingsManager::Browser_PrivateModeOption:
+			m_isPrivateMode = value.toBool();
 
-void TransfersManager::clearTransfers(int period)
-{
-	for (int i = (m_transfers.count() - 1); i >= 0; --i)
-	{
-		if (m_transfers.at(i)->getState() == Transfer::FinishedState && (period == 0 || (m_transfers.at(i)->getTimeFinished().isValid() && m_transfers.at(i)->getTimeFinished().secsTo(QDateTime::currentDateTimeUtc()) > (period * 3600))))
-		{
-			TransfersManager::removeTransfer(m_transfers.at(i));
-		}
+			break;
+		case SettingsManager::History_DownloadsLimitPeriodOption:
+			m_downloadsLimitPeriod = value.toInt();
+
+			break;
+		case SettingsManager::History_RememberDownloadsOption:
+			m_canRememberDownloads = value.toBool();
+
+			break;
+		default:
+			break;
 	}
 }
 
@@ -1114,7 +2333,7 @@ void TransfersManager::handleTransferStarted()
 		emit transferStarted(transfer);
 		emit transfersChanged();
 
-		scheduleSave();
+		markAsModified(transfer);
 	}
 }
 
@@ -1144,11 +2363,10 @@ void TransfersManager::handleTransferFinished()
 		emit transferFinished(transfer);
 		emit transfersChanged();
 
-		if (!m_privateTransfers.contains(transfer))
-		{
-			scheduleSave();
-		}
+		markAsModified(transfer);
 	}
+
+	QTimer::singleShot(0, this, &TransfersManager::scheduleTransfers);
 }
 
 void TransfersManager::handleTransferChanged()
@@ -1157,7 +2375,7 @@ void TransfersManager::handleTransferChanged()
 
 	if (transfer)
 	{
-		scheduleSave();
+		markAsModified(transfer);
 		updateRunningTransfersState();
 
 		emit transferChanged(transfer);
@@ -1176,8 +2394,10 @@ void TransfersManager::handleTransferStopped()
 		emit transferStopped(transfer);
 		emit transfersChanged();
 
-		scheduleSave();
+		markAsModified(transfer);
 	}
+
+	QTimer::singleShot(0, this, &TransfersManager::scheduleTransfers);
 }
 
 TransfersManager* TransfersManager::getInstance()
@@ -1193,7 +2413,22 @@ Transfer* TransfersManager::startTransfer(const QUrl &source, const QString &tar
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
 	request.setUrl(QUrl(source));
 
+	return startTransfer(request, target, options);
+}
+
+Transfer* TransfersManager::startTransfer(const QNetworkRequest &request, const QString &target, Transfer::TransferOptions options)
+{
 	Transfer *transfer(new Transfer(options, m_instance));
+
+	if ((!target.isEmpty() || options.testFlag(Transfer::IsQuickTransferOption)) && !canStartTransfer(request.url().host()))
+	{
+		queueTransfer(transfer, request, target, StartMode);
+
+		addTransfer(transfer);
+
+		return transfer;
+	}
+
 	transfer->start(NetworkManagerFactory::getNetworkManager(options.testFlag(Transfer::IsPrivateOption))->get(request), target);
 
 	if (transfer->getState() == Transfer::CancelledState)
@@ -1208,10 +2443,10 @@ Transfer* TransfersManager::startTransfer(const QUrl &source, const QString &tar
 	return transfer;
 }
 
-Transfer* TransfersManager::startTransfer(const QNetworkRequest &request, const QString &target, Transfer::TransferOptions options)
+Transfer* TransfersManager::startTransfer(QNetworkReply *reply, const QString &target, Transfer::TransferOptions options)
 {
 	Transfer *transfer(new Transfer(options, m_instance));
-	transfer->start(NetworkManagerFactory::getNetworkManager(options.testFlag(Transfer::IsPrivateOption))->get(request), target);
+	transfer->start(reply, target);
 
 	if (transfer->getState() == Transfer::CancelledState)
 	{
@@ -1225,47 +2460,254 @@ Transfer* TransfersManager::startTransfer(const QNetworkRequest &request, const
 	return transfer;
 }
 
-Transfer* TransfersManager::startTransfer(QNetworkReply *reply, const QString &target, Transfer::TransferOptions options)
+void TransfersManager::startQueuedTransfer(Transfer *transfer)
 {
-	Transfer *transfer(new Transfer(options, m_instance));
-	transfer->start(reply, target);
+	for (int i = 0; i < m_queuedTransfers.count(); ++i)
+	{
+		if (m_queuedTransfers.at(i).transfer != transfer)
+		{
+			continue;
+		}
 
-	if (transfer->getState() == Transfer::CancelledState)
+		const QueuedTransfer queuedTransfer(m_queuedTransfers.takeAt(i));
+
+		if (transfer->getState() != Transfer::QueuedState)
+		{
+			return;
+		}
+
+		switch (queuedTransfer.mode)
+		{
+			case RestartMode:
+				if (!transfer->restart())
+				{
+					transfer->stop();
+				}
+
+				break;
+			case ResumeMode:
+				if (!transfer->resume())
+				{
+					transfer->stop();
+				}
+
+				break;
+			default:
+				transfer->start(NetworkManagerFactory::getNetworkManager(transfer->getOptions().testFlag(Transfer::IsPrivateOption))->get(queuedTransfer.request), queuedTransfer.target);
+
+				break;
+		}
+
+		if (!queuedTransfer.transfer)
+		{
+			return;
+		}
+
+		if (transfer->getState() == Transfer::CancelledState)
+		{
+			if (queuedTransfer.mode == StartMode)
+			{
+				removeTransfer(transfer);
+			}
+
+			return;
+		}
+
+		if (transfer->getState() == Transfer::RunningState)
+		{
+			transfer->setUpdateInterval(500);
+
+			m_hasRunningTransfers = true;
+		}
+
+		emit m_instance->transferChanged(transfer);
+
+		for (int j = 0; j < m_queuedTransfers.count(); ++j)
+		{
+			if (m_queuedTransfers.at(j).transfer)
+			{
+				emit m_instance->transferChanged(m_queuedTransfers.at(j).transfer);
+			}
+		}
+
+		emit m_instance->transfersChanged();
+
+		m_instance->markAsModified(transfer);
+
+		return;
+	}
+}
+
+bool TransfersManager::restartTransfer(Transfer *transfer)
+{
+	if (!transfer || transfer->getState() == Transfer::QueuedState)
 	{
-		transfer->deleteLater();
+		return false;
+	}
 
-		return nullptr;
+	if (transfer->getState() == Transfer::RunningState || canStartTransfer(transfer->getSource().host()))
+	{
+		return transfer->restart();
 	}
 
-	addTransfer(transfer);
+	queueTransfer(transfer, QNetworkRequest(transfer->getSource()), transfer->getTarget(), RestartMode);
 
-	return transfer;
+	return true;
+}
+
+bool TransfersManager::resumeTransfer(Transfer *transfer)
+{
+	if (!transfer || transfer->getState() != Transfer::ErrorState)
+	{
+		return false;
+	}
+
+	if (transfer->getBytesReceived() <= 0 || !QFile::exists(transfer->getTarget()))
+	{
+		return restartTransfer(transfer);
+	}
+
+	if (canStartTransfer(transfer->getSource().host()))
+	{
+		return transfer->resume();
+	}
+
+	queueTransfer(transfer, QNetworkRequest(transfer->getSource()), transfer->getTarget(), ResumeMode);
+
+	return true;
+}
+
+void TransfersManager::queueTransfer(Transfer *transfer, const QNetworkRequest &request, const QString &target, QueuedTransferMode mode)
+{
+	QueuedTransfer queuedTransfer;
+	queuedTransfer.transfer = transfer;
+	queuedTransfer.request = request;
+	queuedTransfer.target = target;
+	queuedTransfer.mode = mode;
+
+	m_queuedTransfers.append(queuedTransfer);
+
+	transfer->markAsQueued(request.url());
+
+	QTimer::singleShot(0, m_instance, &TransfersManager::scheduleTransfers);
 }
 
 QVector<Transfer*> TransfersManager::getTransfers()
 {
-	if (!m_isInitilized)
+	if (m_isInitilized)
+	{
+		return m_transfers;
+	}
+
+	m_isInitilized = true;
+
+	QHash<quint64, QVariantMap> records;
+	QSettings history(SessionsManager::getWritableDataPath(QLatin1String("transfers.ini")), QSettings::IniFormat);
+	const QStringList entries(history.childGroups());
+
+	records.reserve(entries.count());
+
+	for (int i = 0; i < entries.count(); ++i)
 	{
-		QSettings history(SessionsManager::getWritableDataPath(QLatin1String("transfers.ini")), QSettings::IniFormat);
-		const QStringList entries(history.childGroups());
+		history.beginGroup(entries.at(i));
 
-		m_transfers.reserve(entries.count());
+		const QStringList keys(history.childKeys());
+		QVariantMap record;
 
-		for (int i = 0; i < entries.count(); ++i)
+		for (int j = 0; j < keys.count(); ++j)
 		{
-			history.beginGroup(entries.at(i));
+			record[keys.at(j)] = history.value(keys.at(j));
+		}
+
+		records[entries.at(i).toULongLong()] = record;
+
+		history.endGroup();
+	}
+
+	QFile file(getJournalPath());
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		QDataStream stream(&file);
+		stream.setVersion(QDataStream::Qt_5_6);
+
+		while (!stream.atEnd())
+		{
+			quint8 operation;
+			quint64 identifier;
+			QVariantMap record;
+
+			stream >> operation >> identifier;
+
+			if (static_cast<TransferOperation>(operation) == UpdateTransfer)
+			{
+				stream >> record;
+			}
+
+			if (stream.status() != QDataStream::Ok)
+			{
+				m_needsCompaction = true;
+
+				break;
+			}
 
-			if (!history.value(QLatin1String("source")).toString().isEmpty() && !history.value(QLatin1String("target")).toString().isEmpty())
+			if (static_cast<TransferOperation>(operation) == RemoveTransfer)
+			{
+				records.remove(identifier);
+			}
+			else
 			{
-				addTransfer(new Transfer(history, m_instance));
+				records[identifier] = record;
 			}
 
-			history.endGroup();
+			++m_journalSize;
+		}
+
+		file.close();
+	}
+
+	QList<quint64> identifiers(records.keys());
+	std::sort(identifiers.begin(), identifiers.end());
+
+	const QList<quint64> existingIdentifiers(m_identifiers.values());
+	const QSet<quint64> activeIdentifiers(existingIdentifiers.toSet());
+	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
+
+	m_transfers.reserve(m_transfers.count() + identifiers.count());
+
+	for (int i = 0; i < identifiers.count(); ++i)
+	{
+		const quint64 identifier(identifiers.at(i));
+		const QVariantMap record(records.value(identifier));
+
+		m_transferIdentifier = qMax(m_transferIdentifier, identifier);
+
+		if (activeIdentifiers.contains(identifier))
+		{
+			continue;
+		}
+
+		if (record.value(QLatin1String("source")).toString().isEmpty() || record.value(QLatin1String("target")).toString().isEmpty())
+		{
+			m_needsCompaction = true;
+
+			continue;
+		}
+
+		Transfer *transfer(new Transfer(record, m_instance));
+
+		if (transfer->getState() == Transfer::FinishedState && transfer->getTimeFinished().isValid() && transfer->getTimeFinished().daysTo(currentDateTime) > m_downloadsLimitPeriod)
+		{
+			transfer->deleteLater();
+
+			m_needsCompaction = true;
+
+			continue;
 		}
 
-		m_isInitilized = true;
+		m_identifiers[transfer] = identifier;
 
-		connect(QCoreApplication::instance(), &Application::aboutToQuit, m_instance, &TransfersManager::save);
+		addTransfer(transfer);
 	}
 
 	return m_transfers;
@@ -1303,6 +2745,90 @@ TransfersManager::ActiveTransfersInformation TransfersManager::getActiveTransfer
 	return information;
 }
 
+qint64 TransfersManager::takeBandwidth(Transfer *transfer, qint64 amount)
+{
+	if (m_bandwidthLimit <= 0 || amount <= 0)
+	{
+		return amount;
+	}
+
+	const qint64 allowedAmount(qMin(amount, m_bandwidthTokens));
+
+	m_bandwidthTokens -= allowedAmount;
+
+	if (allowedAmount < amount && !m_throttledTransfers.contains(transfer))
+	{
+		m_throttledTransfers.append(transfer);
+	}
+
+	if (m_instance->m_bandwidthTimer == 0)
+	{
+		m_instance->m_bandwidthTimer = m_instance->startTimer(100);
+	}
+
+	return allowedAmount;
+}
+
+int TransfersManager::getQueuePosition(Transfer *transfer)
+{
+	int position(0);
+
+	for (int i = 0; i < m_queuedTransfers.count(); ++i)
+	{
+		if (m_queuedTransfers.at(i).transfer && m_queuedTransfers.at(i).transfer->getState() == Transfer::QueuedState)
+		{
+			++position;
+
+			if (m_queuedTransfers.at(i).transfer == transfer)
+			{
+				return position;
+			}
+		}
+	}
+
+	return -1;
+}
+
+QVariantMap TransfersManager::createRecord(Transfer *transfer)
+{
+	QVariantMap record;
+	record[QLatin1String("source")] = transfer->getSource().toString();
+	record[QLatin1String("target")] = transfer->getTarget();
+	record[QLatin1String("timeStarted")] = transfer->getTimeStarted().toString(Qt::ISODate);
+	record[QLatin1String("timeFinished")] = ((transfer->getTimeFinished().isValid() && transfer->getState() != Transfer::RunningState) ? transfer->getTimeFinished() : QDateTime::currentDateTimeUtc()).toString(Qt::ISODate);
+	record[QLatin1String("bytesTotal")] = transfer->getBytesTotal();
+	record[QLatin1String("bytesReceived")] = transfer->getBytesReceived();
+
+	const QStringList segments(transfer->getSegmentsState());
+
+	if (!segments.isEmpty())
+	{
+		record[QLatin1String("segments")] = segments;
+	}
+
+	if (!transfer->m_hashes.isEmpty())
+	{
+		record[QLatin1String("hashes")] = Transfer::saveHashes(transfer->m_hashes);
+	}
+
+	if (!transfer->m_computedHashes.isEmpty())
+	{
+		record[QLatin1String("computedHashes")] = Transfer::saveHashes(transfer->m_computedHashes);
+	}
+
+	if (!transfer->m_validator.isEmpty())
+	{
+		record[QLatin1String("validator")] = QString::fromLatin1(transfer->m_validator);
+	}
+
+	return record;
+}
+
+QString TransfersManager::getJournalPath()
+{
+	return SessionsManager::getWritableDataPath(QLatin1String("transfers.journal"));
+}
+
 bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 {
 	if (!transfer || !m_transfers.contains(transfer))
@@ -1312,7 +2838,22 @@ bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 
 	m_transfers.removeAll(transfer);
 
-	m_privateTransfers.removeAll(transfer);
+	if (m_identifiers.contains(transfer))
+	{
+		m_removedTransfers.append(m_identifiers.take(transfer));
+
+		m_modifiedTransfers.remove(transfer);
+
+		m_instance->scheduleSave();
+	}
+
+	for (int i = (m_queuedTransfers.count() - 1); i >= 0; --i)
+	{
+		if (m_queuedTransfers.at(i).transfer == transfer)
+		{
+			m_queuedTransfers.removeAt(i);
+		}
+	}
 
 	if (transfer->getState() == Transfer::RunningState)
 	{
@@ -1329,6 +2870,8 @@ bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 
 	transfer->deleteLater();
 
+	QTimer::singleShot(0, m_instance, &TransfersManager::scheduleTransfers);
+
 	return true;
 }
 
@@ -1365,9 +2908,48 @@ bool TransfersManager::isDownloading(const QString &source, const QString &targe
 	return false;
 }
 
+bool TransfersManager::canStartTransfer(const QString &host)
+{
+	if (!m_queuedTransfers.isEmpty())
+	{
+		return false;
+	}
+
+	int activeTransfers(0);
+	int hostTransfers(0);
+
+	for (int i = 0; i < m_transfers.count(); ++i)
+	{
+		if (m_transfers.at(i)->getState() == Transfer::RunningState)
+		{
+			++activeTransfers;
+
+			if (m_transfers.at(i)->getSource().host() == host)
+			{
+				++hostTransfers;
+			}
+		}
+	}
+
+	return ((m_transfersLimit <= 0 || activeTransfers < m_transfersLimit) && (m_hostTransfersLimit <= 0 || hostTransfers < m_hostTransfersLimit));
+}
+
 bool TransfersManager::hasRunningTransfers()
 {
 	return m_hasRunningTransfers;
 }
 
+bool TransfersManager::hasQueuedTransfers()
+{
+	for (int i = 0; i < m_queuedTransfers.count(); ++i)
+	{
+		if (m_queuedTransfers.at(i).transfer && m_queuedTransfers.at(i).transfer->getState() == Transfer::QueuedState)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 }
@@ -20,11 +20,13 @@
 #ifndef OTTER_TRANSFERSMANAGER_H
 #define OTTER_TRANSFERSMANAGER_H
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QMimeType>
 #include <QtCore/QPointer>
 #include <QtCore/QQueue>
-#include <QtCore/QSettings>
+#include <QtCore/QSet>
 #include <QtNetwork/QNetworkReply>
 
 namespace Otter
@@ -56,6 +58,7 @@ public:
 		UnknownState = 0,
 		ErrorState,
 		CancelledState,
+		QueuedState,
 		RunningState,
 		FinishedState
 	};
@@ -91,10 +94,34 @@ public slots:
 
 protected:
 	explicit Transfer(TransferOptions options = CanAskForPathOption, QObject *parent = nullptr);
-	explicit Transfer(const QSettings &settings, QObject *parent = nullptr);
+	explicit Transfer(const QVariantMap &information, QObject *parent = nullptr);
 
 	void timerEvent(QTimerEvent *event) override;
 	void start(QNetworkReply *reply, const QString &target);
+	void markAsQueued(const QUrl &source);
+	void readThrottledData();
+	void startSegmentedTransfer();
+	void startSegment(int index);
+	void writeSegmentData(int index);
+	void releaseSegment(int index);
+	void disableSegmentation();
+	void finishSegmentedTransfer();
+	void startTargetCopy(const QString &target);
+	void discardTargetCopy();
+	void replaceDevice(QFile *device);
+	void resetDigests();
+	void updateDigests(const QByteArray &data, qint64 offset);
+	void readDigestsData(qint64 limit);
+	void finalizeDigests();
+	QNetworkRequest createRangeRequest(qint64 offset, qint64 end = -1) const;
+	QStringList getSegmentsState() const;
+	qint64 getContiguousBytes() const;
+	int getSegment(QNetworkReply *reply) const;
+	static QString copyFile(const QString &source, const QString &target);
+	static QByteArray getValidator(QNetworkReply *reply);
+	static QHash<QCryptographicHash::Algorithm, QByteArray> loadHashes(const QStringList &hashes);
+	static QStringList saveHashes(const QHash<QCryptographicHash::Algorithm, QByteArray> &hashes);
+	static bool moveFile(const QString &source, const QString &target);
 
 protected slots:
 	void markAsStarted();
@@ -103,26 +130,48 @@ protected slots:
 	void handleDataAvailable();
 	void handleDownloadFinished();
 	void handleDownloadError(QNetworkReply::NetworkError error);
+	void handleMetaDataChanged();
+	void handleSegmentDataAvailable();
+	void handleSegmentFinished();
+	void handleTargetCopied();
 
 private:
+	struct Segment final
+	{
+		QPointer<QNetworkReply> reply;
+		qint64 offset = 0;
+		qint64 end = 0;
+		qint64 bytesReceived = 0;
+		bool isConfirmed = false;
+	};
+
 	QPointer<QNetworkReply> m_reply;
 	QPointer<QFile> m_device;
+	QFutureWatcher<QString> *m_copyWatcher;
+	QNetworkRequest m_request;
 	QUrl m_source;
 	QString m_target;
 	QString m_openCommand;
 	QString m_suggestedFileName;
+	QString m_copyTarget;
+	QByteArray m_validator;
 	QDateTime m_timeStarted;
 	QDateTime m_timeFinished;
 	QMimeType m_mimeType;
 	QHash<QCryptographicHash::Algorithm, QByteArray> m_hashes;
+	QHash<QCryptographicHash::Algorithm, QByteArray> m_computedHashes;
+	QHash<QCryptographicHash::Algorithm, QCryptographicHash*> m_digests;
+	QVector<Segment> m_segments;
 	QQueue<qint64> m_speeds;
 	qint64 m_speed;
 	qint64 m_bytesStart;
 	qint64 m_bytesReceivedDifference;
 	qint64 m_bytesReceived;
 	qint64 m_bytesTotal;
+	qint64 m_hashedBytes;
 	TransferOptions m_options;
 	TransferState m_state;
+	TransferState m_previousState;
 	int m_updateTimer;
 	int m_updateInterval;
 	int m_remainingTime;
@@ -159,34 +208,84 @@ public:
 	static Transfer* startTransfer(const QUrl &source, const QString &target = {}, Transfer::TransferOptions options = Transfer::CanAskForPathOption);
 	static Transfer* startTransfer(const QNetworkRequest &request, const QString &target = {}, Transfer::TransferOptions options = Transfer::CanAskForPathOption);
 	static Transfer* startTransfer(QNetworkReply *reply, const QString &target = {}, Transfer::TransferOptions options = Transfer::CanAskForPathOption);
+	static void startQueuedTransfer(Transfer *transfer);
+	static bool restartTransfer(Transfer *transfer);
+	static bool resumeTransfer(Transfer *transfer);
 	static QVector<Transfer*> getTransfers();
 	static ActiveTransfersInformation getActiveTransfersInformation();
+	static qint64 takeBandwidth(Transfer *transfer, qint64 amount);
+	static int getQueuePosition(Transfer *transfer);
 	static bool removeTransfer(Transfer *transfer, bool keepFile = true);
 	static bool isDownloading(const QString &source, const QString &target = {});
 	static bool hasRunningTransfers();
+	static bool hasQueuedTransfers();
 
 protected:
+	enum TransferOperation
+	{
+		UpdateTransfer = 0,
+		RemoveTransfer
+	};
+
+	enum QueuedTransferMode
+	{
+		StartMode = 0,
+		RestartMode,
+		ResumeMode
+	};
+
 	explicit TransfersManager(QObject *parent);
 
 	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
+	void markAsModified(Transfer *transfer);
+	void compact();
 	void updateRunningTransfersState();
+	static void queueTransfer(Transfer *transfer, const QNetworkRequest &request, const QString &target, QueuedTransferMode mode);
+	static QVariantMap createRecord(Transfer *transfer);
+	static QString getJournalPath();
+	static bool canStartTransfer(const QString &host);
 
 protected slots:
 	void save();
+	void scheduleTransfers();
+	void handleOptionChanged(int identifier, const QVariant &value);
 	void handleTransferStarted();
 	void handleTransferFinished();
 	void handleTransferChanged();
 	void handleTransferStopped();
 
 private:
+	struct QueuedTransfer final
+	{
+		QPointer<Transfer> transfer;
+		QNetworkRequest request;
+		QString target;
+		QueuedTransferMode mode = StartMode;
+	};
+
 	int m_saveTimer;
+	int m_bandwidthTimer;
 
 	static TransfersManager *m_instance;
 	static QVector<Transfer*> m_transfers;
-	static QVector<Transfer*> m_privateTransfers;
+	static QVector<QueuedTransfer> m_queuedTransfers;
+	static QVector<QPointer<Transfer> > m_throttledTransfers;
+	static QHash<Transfer*, quint64> m_identifiers;
+	static QSet<Transfer*> m_modifiedTransfers;
+	static QVector<quint64> m_removedTransfers;
+	static quint64 m_transferIdentifier;
+	static qint64 m_bandwidthLimit;
+	static qint64 m_bandwidthTokens;
+	static int m_transfersLimit;
+	static int m_hostTransfersLimit;
+	static int m_downloadsLimitPeriod;
+	static int m_journalSize;
 	static bool m_isInitilized;
 	static bool m_hasRunningTransfers;
+	static bool m_isPrivateMode;
+	static bool m_canRememberDownloads;
+	static bool m_needsCompaction;
 
 signals:
 	void transferStarted(Transfer *transfer);
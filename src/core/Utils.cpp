@@ -711,6 +711,50 @@ SaveInformation getSavePath(const QString &fileName, const QString &directory, Q
 	return information;
 }
 
+qint64 getAvailableMemory()
+{
+#ifdef Q_OS_LINUX
+	QFile file(QLatin1String("/proc/meminfo"));
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		const QList<QByteArray> lines(file.readAll().split('\n'));
+
+		for (int i = 0; i < lines.count(); ++i)
+		{
+			if (lines.at(i).startsWith("MemAvailable:"))
+			{
+				return (lines.at(i).mid(13).simplified().split(' ').value(0).toLongLong() * 1024);
+			}
+		}
+	}
+#endif
+
+	return -1;
+}
+
+qint64 getProcessMemoryUsage()
+{
+#ifdef Q_OS_LINUX
+	QFile file(QLatin1String("/proc/self/status"));
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		const QList<QByteArray> lines(file.readAll().split('\n'));
+
+		for (int i = 0; i < lines.count(); ++i)
+		{
+			if (lines.at(i).startsWith("VmRSS:"))
+			{
+				return (lines.at(i).mid(6).simplified().split(' ').value(0).toLongLong() * 1024);
+			}
+		}
+	}
+#endif
+
+	return -1;
+}
+
 qreal calculatePercent(qint64 amount, qint64 total, int multiplier)
 {
 	return ((static_cast<qreal>(amount) / static_cast<qreal>(total)) * multiplier);
@@ -27,6 +27,8 @@
 
 #include <QtCore/QCoreApplication>
 
+#define REQUEST_TIMINGS_LIMIT 500
+
 namespace Otter
 {
 
@@ -36,6 +38,9 @@ WebBackend* QtWebEngineUrlRequestInterceptor::m_backend(nullptr);
 QtWebEngineUrlRequestInterceptor::QtWebEngineUrlRequestInterceptor(QtWebEngineWebWidget *parent) : QWebEngineUrlRequestInterceptor(parent),
 	m_widget(parent),
 	m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy),
+	m_requestTimingIdentifier(0),
+	m_startedRequestsAmount(0),
+	m_pageInformationTimer(0),
 	m_areImagesEnabled(true),
 	m_canSendReferrer(true)
 {
@@ -52,51 +57,8 @@ void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo
 
 	if (!m_contentBlockingProfiles.isEmpty() && (m_unblockedHosts.isEmpty() || !m_unblockedHosts.contains(Utils::extractHost(request.firstPartyUrl()))))
 	{
-		NetworkManager::ResourceType resourceType(NetworkManager::OtherType);
-		bool storeBlockedUrl(true);
-
-		switch (request.resourceType())
-		{
-			case QWebEngineUrlRequestInfo::ResourceTypeMainFrame:
-				resourceType = NetworkManager::MainFrameType;
-
-				break;
-			case QWebEngineUrlRequestInfo::ResourceTypeSubFrame:
-				resourceType = NetworkManager::SubFrameType;
-
-				break;
-			case QWebEngineUrlRequestInfo::ResourceTypeStylesheet:
-				resourceType = NetworkManager::StyleSheetType;
-				storeBlockedUrl = false;
-
-				break;
-			case QWebEngineUrlRequestInfo::ResourceTypeScript:
-				resourceType = NetworkManager::ScriptType;
-				storeBlockedUrl = false;
-
-				break;
-			case QWebEngineUrlRequestInfo::ResourceTypeImage:
-				resourceType = NetworkManager::ImageType;
-
-				break;
-			case QWebEngineUrlRequestInfo::ResourceTypeObject:
-			case QWebEngineUrlRequestInfo::ResourceTypeMedia:
-				resourceType = NetworkManager::ObjectType;
-
-				break;
-			case QWebEngineUrlRequestInfo::ResourceTypePluginResource:
-				resourceType = NetworkManager::ObjectSubrequestType;
-				storeBlockedUrl = false;
-
-				break;
-			case QWebEngineUrlRequestInfo::ResourceTypeXhr:
-				resourceType = NetworkManager::XmlHttpRequestType;
-
-				break;
-			default:
-				break;
-		}
-
+		const NetworkManager::ResourceType resourceType(getResourceType(request.resourceType()));
+		const bool storeBlockedUrl(resourceType != NetworkManager::StyleSheetType && resourceType != NetworkManager::ScriptType && resourceType != NetworkManager::ObjectSubrequestType);
 		const ContentFiltersManager::CheckResult result(ContentFiltersManager::checkUrl(m_contentBlockingProfiles, request.firstPartyUrl(), request.requestUrl(), resourceType));
 
 		if (result.isBlocked)
@@ -118,7 +80,9 @@ void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo
 
 			m_blockedRequests.append(resource);
 
-			emit pageInformationChanged(WebWidget::RequestsBlockedInformation, m_blockedRequests.count());
+			addRequestTiming(request, resourceType, result.rule);
+			markPageInformationAsChanged(WebWidget::RequestsBlockedInformation);
+
 			emit requestBlocked(resource);
 
 			request.block(true);
@@ -129,6 +93,8 @@ void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo
 
 	++m_startedRequestsAmount;
 
+	addRequestTiming(request, getResourceType(request.resourceType()));
+
 	request.setHttpHeader(QByteArrayLiteral("Accept-Language"), (m_acceptLanguage.isEmpty() ? NetworkManagerFactory::getAcceptLanguage().toLatin1() : m_acceptLanguage.toLatin1()));
 	request.setHttpHeader(QByteArrayLiteral("User-Agent"), m_userAgent.toUtf8());
 
@@ -142,14 +108,83 @@ void QtWebEngineUrlRequestInterceptor::interceptRequest(QWebEngineUrlRequestInfo
 		request.setHttpHeader(QByteArrayLiteral("Referer"), {});
 	}
 
-	emit pageInformationChanged(WebWidget::RequestsStartedInformation, m_startedRequestsAmount);
+	markPageInformationAsChanged(WebWidget::RequestsStartedInformation);
+}
+
+void QtWebEngineUrlRequestInterceptor::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_pageInformationTimer)
+	{
+		killTimer(m_pageInformationTimer);
+
+		m_pageInformationTimer = 0;
+
+		const QVector<WebWidget::PageInformation> keys(m_changedPageInformation);
+
+		m_changedPageInformation.clear();
+
+		for (int i = 0; i < keys.count(); ++i)
+		{
+			emit pageInformationChanged(keys.at(i), getPageInformation(keys.at(i)));
+		}
+	}
+}
+
+void QtWebEngineUrlRequestInterceptor::addRequestTiming(const QWebEngineUrlRequestInfo &request, NetworkManager::ResourceType resourceType, const QString &rule)
+{
+	++m_requestTimingIdentifier;
+
+	NetworkManager::RequestTiming timing;
+	timing.url = request.requestUrl();
+	timing.method = QString::fromLatin1(request.requestMethod());
+	timing.rule = rule;
+	timing.queuedTime = QDateTime::currentMSecsSinceEpoch();
+	timing.startedTime = timing.queuedTime;
+	timing.identifier = m_requestTimingIdentifier;
+	timing.resourceType = resourceType;
+	timing.isBlocked = !rule.isEmpty();
+
+	if (timing.isBlocked)
+	{
+		timing.finishedTime = timing.queuedTime;
+	}
+
+	const int index(static_cast<int>((m_requestTimingIdentifier - 1) % REQUEST_TIMINGS_LIMIT));
+
+	if (index < m_requestTimings.count())
+	{
+		m_requestTimings[index] = timing;
+	}
+	else
+	{
+		m_requestTimings.append(timing);
+	}
+}
+
+void QtWebEngineUrlRequestInterceptor::markPageInformationAsChanged(WebWidget::PageInformation key)
+{
+	if (!m_changedPageInformation.contains(key))
+	{
+		m_changedPageInformation.append(key);
+	}
+
+	if (m_pageInformationTimer == 0)
+	{
+		m_pageInformationTimer = startTimer(100);
+	}
 }
 
 void QtWebEngineUrlRequestInterceptor::resetStatistics()
 {
+	killTimer(m_pageInformationTimer);
+
 	m_blockedRequests.clear();
 	m_blockedElements.clear();
+	m_changedPageInformation.clear();
+	m_requestTimings.clear();
+	m_requestTimingIdentifier = 0;
 	m_startedRequestsAmount = 0;
+	m_pageInformationTimer = 0;
 }
 
 void QtWebEngineUrlRequestInterceptor::updateOptions(const QUrl &url)
@@ -199,6 +234,34 @@ QVariant QtWebEngineUrlRequestInterceptor::getOption(int identifier, const QUrl
 	return (m_widget ? m_widget->getOption(identifier, url) : SettingsManager::getOption(identifier, Utils::extractHost(url)));
 }
 
+NetworkManager::ResourceType QtWebEngineUrlRequestInterceptor::getResourceType(QWebEngineUrlRequestInfo::ResourceType type)
+{
+	switch (type)
+	{
+		case QWebEngineUrlRequestInfo::ResourceTypeMainFrame:
+			return NetworkManager::MainFrameType;
+		case QWebEngineUrlRequestInfo::ResourceTypeSubFrame:
+			return NetworkManager::SubFrameType;
+		case QWebEngineUrlRequestInfo::ResourceTypeStylesheet:
+			return NetworkManager::StyleSheetType;
+		case QWebEngineUrlRequestInfo::ResourceTypeScript:
+			return NetworkManager::ScriptType;
+		case QWebEngineUrlRequestInfo::ResourceTypeImage:
+			return NetworkManager::ImageType;
+		case QWebEngineUrlRequestInfo::ResourceTypeObject:
+		case QWebEngineUrlRequestInfo::ResourceTypeMedia:
+			return NetworkManager::ObjectType;
+		case QWebEngineUrlRequestInfo::ResourceTypePluginResource:
+			return NetworkManager::ObjectSubrequestType;
+		case QWebEngineUrlRequestInfo::ResourceTypeXhr:
+			return NetworkManager::XmlHttpRequestType;
+		default:
+			break;
+	}
+
+	return NetworkManager::OtherType;
+}
+
 QVariant QtWebEngineUrlRequestInterceptor::getPageInformation(WebWidget::PageInformation key) const
 {
 	switch (key)
@@ -224,6 +287,18 @@ QVector<NetworkManager::ResourceInformation> QtWebEngineUrlRequestInterceptor::g
 {
 	return m_blockedRequests;
 }
+
+QVector<NetworkManager::RequestTiming> QtWebEngineUrlRequestInterceptor::getRequestTimings() const
+{
+	if (m_requestTimings.count() < REQUEST_TIMINGS_LIMIT)
+	{
+		return m_requestTimings;
+	}
+
+	const int index(static_cast<int>(m_requestTimingIdentifier % REQUEST_TIMINGS_LIMIT));
+
+	return (m_requestTimings.mid(index) + m_requestTimings.mid(0, index));
+}
 #else
 QtWebEngineUrlRequestInterceptor::QtWebEngineUrlRequestInterceptor(QObject *parent) : QWebEngineUrlRequestInterceptor(parent),
 	m_clearTimer(0),
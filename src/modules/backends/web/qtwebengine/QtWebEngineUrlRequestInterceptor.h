@@ -46,11 +46,16 @@ public:
 	void interceptRequest(QWebEngineUrlRequestInfo &request) override;
 	QStringList getBlockedElements() const;
 	QVector<NetworkManager::ResourceInformation> getBlockedRequests() const;
+	QVector<NetworkManager::RequestTiming> getRequestTimings() const;
 
 protected:
+	void timerEvent(QTimerEvent *event) override;
+	void addRequestTiming(const QWebEngineUrlRequestInfo &request, NetworkManager::ResourceType resourceType, const QString &rule = {});
+	void markPageInformationAsChanged(WebWidget::PageInformation key);
 	void updateOptions(const QUrl &url);
 	QVariant getOption(int identifier, const QUrl &url) const;
 	QVariant getPageInformation(WebWidget::PageInformation key) const;
+	static NetworkManager::ResourceType getResourceType(QWebEngineUrlRequestInfo::ResourceType type);
 
 protected slots:
 	void resetStatistics();
@@ -63,8 +68,12 @@ private:
 	QStringList m_unblockedHosts;
 	QVector<NetworkManager::ResourceInformation> m_blockedRequests;
 	QVector<int> m_contentBlockingProfiles;
+	QVector<WebWidget::PageInformation> m_changedPageInformation;
+	QVector<NetworkManager::RequestTiming> m_requestTimings;
 	NetworkManagerFactory::DoNotTrackPolicy m_doNotTrackPolicy;
+	quint64 m_requestTimingIdentifier;
 	quint64 m_startedRequestsAmount;
+	int m_pageInformationTimer;
 	bool m_areImagesEnabled;
 	bool m_canSendReferrer;
 
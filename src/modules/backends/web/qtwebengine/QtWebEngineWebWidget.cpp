@@ -76,6 +76,7 @@ QtWebEngineWebWidget::QtWebEngineWebWidget(const QVariantMap &parameters, WebBac
 #endif
 	m_loadingState(FinishedLoadingState),
 	m_canGoForwardValue(UnknownValue),
+	m_estimatedMemoryUsage(0),
 	m_documentLoadingProgress(0),
 	m_focusProxyTimer(0),
 	m_updateNavigationActionsTimer(0),
@@ -178,6 +179,8 @@ void QtWebEngineWebWidget::hideEvent(QHideEvent *event)
 	killTimer(m_focusProxyTimer);
 
 	m_focusProxyTimer = 0;
+
+	updateEstimatedMemoryUsage();
 }
 
 void QtWebEngineWebWidget::focusInEvent(QFocusEvent *event)
@@ -954,6 +957,7 @@ void QtWebEngineWebWidget::handleLoadFinished()
 
 	notifyNavigationActionsChanged();
 	startReloadTimer();
+	updateEstimatedMemoryUsage();
 
 	m_page->runJavaScript(getFastForwardScript(false), [&](const QVariant &result)
 	{
@@ -1101,8 +1105,6 @@ void QtWebEngineWebWidget::notifyUrlChanged()
 	emit iconChanged(getIcon());
 	emit urlChanged((url.toString() == QLatin1String("about:blank")) ? m_page->requestedUrl() : url);
 	emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::PageCategory});
-
-	SessionsManager::markSessionAsModified();
 }
 
 void QtWebEngineWebWidget::notifyIconChanged()
@@ -1198,6 +1200,14 @@ void QtWebEngineWebWidget::notifyWatchedDataChanged(ChangeWatcher watcher)
 	emit watchedDataChanged(watcher);
 }
 
+void QtWebEngineWebWidget::updateEstimatedMemoryUsage()
+{
+	m_page->runJavaScript(m_page->createScriptSource(QLatin1String("getMemoryUsage")), [&](const QVariant &result)
+	{
+		m_estimatedMemoryUsage = qMax(0LL, result.toLongLong());
+	});
+}
+
 void QtWebEngineWebWidget::updateOptions(const QUrl &url)
 {
 	const QString encoding(getOption(SettingsManager::Content_DefaultCharacterEncodingOption, url).toString());
@@ -1770,6 +1780,11 @@ QVector<NetworkManager::ResourceInformation> QtWebEngineWebWidget::getBlockedReq
 {
 	return m_requestInterceptor->getBlockedRequests();
 }
+
+QVector<NetworkManager::RequestTiming> QtWebEngineWebWidget::getRequestTimings() const
+{
+	return m_requestInterceptor->getRequestTimings();
+}
 #endif
 
 QMultiMap<QString, QString> QtWebEngineWebWidget::getMetaData() const
@@ -1782,6 +1797,16 @@ WebWidget::LoadingState QtWebEngineWebWidget::getLoadingState() const
 	return m_loadingState;
 }
 
+qint64 QtWebEngineWebWidget::getEstimatedMemoryUsage() const
+{
+	if (m_loadingState == DeferredLoadingState)
+	{
+		return 0;
+	}
+
+	return (WebWidget::getEstimatedMemoryUsage() + m_estimatedMemoryUsage);
+}
+
 int QtWebEngineWebWidget::getZoom() const
 {
 	return static_cast<int>(m_page->zoomFactor() * 100);
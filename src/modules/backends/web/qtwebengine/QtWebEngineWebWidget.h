@@ -91,9 +91,11 @@ public:
 	QVector<LinkUrl> getSearchEngines() const override;
 #if QTWEBENGINECORE_VERSION >= 0x050D00
 	QVector<NetworkManager::ResourceInformation> getBlockedRequests() const override;
+	QVector<NetworkManager::RequestTiming> getRequestTimings() const override;
 #endif
 	QMultiMap<QString, QString> getMetaData() const override;
 	LoadingState getLoadingState() const override;
+	qint64 getEstimatedMemoryUsage() const override;
 	int getZoom() const override;
 	bool hasSelection() const override;
 	bool hasWatchedChanges(ChangeWatcher watcher) const override;
@@ -124,6 +126,7 @@ protected:
 	void focusInEvent(QFocusEvent *event) override;
 	void ensureInitialized();
 	void notifyWatchedDataChanged(ChangeWatcher watcher);
+	void updateEstimatedMemoryUsage();
 	void updateOptions(const QUrl &url);
 	void updateWatchedData(ChangeWatcher watcher) override;
 	void setHistory(QDataStream &stream);
@@ -185,6 +188,7 @@ private:
 	QVector<bool> m_watchedChanges;
 	LoadingState m_loadingState;
 	TrileanValue m_canGoForwardValue;
+	qint64 m_estimatedMemoryUsage;
 	int m_documentLoadingProgress;
 	int m_focusProxyTimer;
 	int m_updateNavigationActionsTimer;
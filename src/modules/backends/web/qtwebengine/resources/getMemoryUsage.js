@@ -0,0 +1,23 @@
+(function(window)
+{
+	let usage = (document.getElementsByTagName('*').length * 256);
+	let images = document.images;
+	let canvases = document.getElementsByTagName('canvas');
+
+	for (let i = 0; i < images.length; ++i)
+	{
+		usage += (images[i].naturalWidth * images[i].naturalHeight * 4);
+	}
+
+	for (let i = 0; i < canvases.length; ++i)
+	{
+		usage += (canvases[i].width * canvases[i].height * 4);
+	}
+
+	if (window.performance && window.performance.memory)
+	{
+		usage += window.performance.memory.usedJSHeapSize;
+	}
+
+	return usage;
+})(window);
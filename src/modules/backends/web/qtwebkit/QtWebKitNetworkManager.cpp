@@ -23,6 +23,7 @@
 #include "QtWebKitCookieJar.h"
 #include "QtWebKitFtpListingNetworkReply.h"
 #include "QtWebKitPage.h"
+#include "QtWebKitScheduledNetworkReply.h"
 #include "../../../../core/AddonsManager.h"
 #include "../../../../core/Console.h"
 #include "../../../../core/CookieJar.h"
@@ -47,10 +48,16 @@
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QNetworkReply>
 
+#define BACKGROUND_TAB_REQUESTS_LIMIT 4
+#define HOST_REQUESTS_LIMIT 6
+#define REQUEST_TIMINGS_LIMIT 500
+
 namespace Otter
 {
 
 WebBackend* QtWebKitNetworkManager::m_backend(nullptr);
+QVector<QPointer<QtWebKitScheduledNetworkReply> > QtWebKitNetworkManager::m_scheduledReplies;
+QHash<QString, int> QtWebKitNetworkManager::m_hostRequests;
 
 QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar *cookieJarProxy, QtWebKitWebWidget *parent) : QNetworkAccessManager(parent),
 	m_widget(parent),
@@ -62,7 +69,10 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy),
 	m_isSecureValue(UnknownValue),
 	m_bytesReceivedDifference(0),
+	m_requestTimingIdentifier(0),
 	m_loadingSpeedTimer(0),
+	m_pageInformationTimer(0),
+	m_backgroundRequests(0),
 	m_areImagesEnabled(true),
 	m_canSendReferrer(true)
 {
@@ -82,6 +92,8 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	else
 	{
 		m_cookieJar = new CookieJar({}, this);
+
+		setCache(new NetworkCache(true, this));
 	}
 
 	if (m_cookieJarProxy)
@@ -108,12 +120,45 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	});
 }
 
+QtWebKitNetworkManager::~QtWebKitNetworkManager()
+{
+	for (int i = (m_scheduledReplies.count() - 1); i >= 0; --i)
+	{
+		if (!m_scheduledReplies.at(i) || m_scheduledReplies.at(i)->parent() == this)
+		{
+			m_scheduledReplies.removeAt(i);
+		}
+	}
+
+	const QList<QObject*> replies(m_requests.keys());
+
+	for (int i = 0; i < replies.count(); ++i)
+	{
+		finishRequest(replies.at(i));
+	}
+}
+
 void QtWebKitNetworkManager::timerEvent(QTimerEvent *event)
 {
 	if (event->timerId() == m_loadingSpeedTimer)
 	{
 		updateLoadingSpeed();
 	}
+	else if (event->timerId() == m_pageInformationTimer)
+	{
+		killTimer(m_pageInformationTimer);
+
+		m_pageInformationTimer = 0;
+
+		const QVector<WebWidget::PageInformation> keys(m_changedPageInformation);
+
+		m_changedPageInformation.clear();
+
+		for (int i = 0; i < keys.count(); ++i)
+		{
+			emit pageInformationChanged(keys.at(i), getPageInformation(keys.at(i)));
+		}
+	}
 }
 
 void QtWebKitNetworkManager::addContentBlockingException(const QUrl &url, NetworkManager::ResourceType resourceType)
@@ -129,28 +174,44 @@ void QtWebKitNetworkManager::addContentBlockingException(const QUrl &url, Networ
 void QtWebKitNetworkManager::resetStatistics()
 {
 	killTimer(m_loadingSpeedTimer);
+	killTimer(m_pageInformationTimer);
 
-	const QList<WebWidget::PageInformation> keys(m_pageInformation.keys());
+	QVector<WebWidget::PageInformation> keys({WebWidget::DocumentBytesReceivedInformation, WebWidget::DocumentBytesTotalInformation, WebWidget::TotalBytesReceivedInformation, WebWidget::TotalBytesTotalInformation, WebWidget::RequestsFinishedInformation, WebWidget::RequestsStartedInformation});
+	const QList<WebWidget::PageInformation> previousKeys(m_pageInformation.keys());
+
+	for (int i = 0; i < previousKeys.count(); ++i)
+	{
+		if (!keys.contains(previousKeys.at(i)))
+		{
+			keys.append(previousKeys.at(i));
+		}
+	}
 
 	m_sslInformation = {};
 	m_loadingSpeedTimer = 0;
+	m_pageInformationTimer = 0;
 	m_blockedElements.clear();
 	m_contentBlockingProfiles.clear();
 	m_contentBlockingExceptions.clear();
 	m_blockedRequests.clear();
 	m_replies.clear();
 	m_headers.clear();
-	m_pageInformation = {{WebWidget::DocumentBytesReceivedInformation, quint64(0)}, {WebWidget::DocumentBytesTotalInformation, quint64(0)}, {WebWidget::TotalBytesReceivedInformation, quint64(0)}, {WebWidget::TotalBytesTotalInformation, quint64(0)}, {WebWidget::RequestsFinishedInformation, 0}, {WebWidget::RequestsStartedInformation, 0}};
+	m_pageInformation.clear();
+	m_changedPageInformation.clear();
+	m_pageStatistics = PageStatistics();
 	m_baseReply = nullptr;
 	m_contentState = WebWidget::UnknownContentState;
 	m_isSecureValue = UnknownValue;
 	m_bytesReceivedDifference = 0;
+	m_requestTimingIdentifier = 0;
+	m_requestTimingIdentifiers.clear();
+	m_requestTimings.clear();
 
 	updateLoadingSpeed();
 
 	for (int i = 0; i < keys.count(); ++i)
 	{
-		emit pageInformationChanged(keys.at(i), m_pageInformation.value(keys.at(i)));
+		emit pageInformationChanged(keys.at(i), getPageInformation(keys.at(i)));
 	}
 
 	emit contentStateChanged(m_contentState);
@@ -168,6 +229,50 @@ void QtWebKitNetworkManager::registerTransfer(QNetworkReply *reply)
 	}
 }
 
+quint64 QtWebKitNetworkManager::addRequestTiming(NetworkManager::RequestTiming timing)
+{
+	++m_requestTimingIdentifier;
+
+	timing.identifier = m_requestTimingIdentifier;
+
+	const int index(static_cast<int>((m_requestTimingIdentifier - 1) % REQUEST_TIMINGS_LIMIT));
+
+	if (index < m_requestTimings.count())
+	{
+		m_requestTimings[index] = timing;
+	}
+	else
+	{
+		m_requestTimings.append(timing);
+	}
+
+	return m_requestTimingIdentifier;
+}
+
+void QtWebKitNetworkManager::finishRequest(QObject *reply)
+{
+	if (!m_requests.contains(reply))
+	{
+		return;
+	}
+
+	const RequestInformation information(m_requests.take(reply));
+
+	--m_hostRequests[information.host];
+
+	if (m_hostRequests.value(information.host) <= 0)
+	{
+		m_hostRequests.remove(information.host);
+	}
+
+	if (information.isBackground)
+	{
+		--m_backgroundRequests;
+	}
+
+	startScheduledRequests();
+}
+
 void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
 {
 	QNetworkReply *reply(qobject_cast<QNetworkReply*>(sender()));
@@ -180,9 +285,13 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 		}
 		else
 		{
-			setPageInformation(WebWidget::DocumentBytesReceivedInformation, bytesReceived);
-			setPageInformation(WebWidget::DocumentBytesTotalInformation, bytesTotal);
-			setPageInformation(WebWidget::DocumentLoadingProgressInformation, ((bytesTotal > 0) ? Utils::calculatePercent(bytesReceived, bytesTotal) : -1));
+			m_pageStatistics.documentBytesReceived = bytesReceived;
+			m_pageStatistics.documentBytesTotal = bytesTotal;
+			m_pageStatistics.documentLoadingProgress = ((bytesTotal > 0) ? Utils::calculatePercent(bytesReceived, bytesTotal) : -1);
+
+			markPageInformationAsChanged(WebWidget::DocumentBytesReceivedInformation);
+			markPageInformationAsChanged(WebWidget::DocumentBytesTotalInformation);
+			markPageInformationAsChanged(WebWidget::DocumentLoadingProgressInformation);
 		}
 	}
 
@@ -191,11 +300,23 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 		return;
 	}
 
+	NetworkManager::RequestTiming *timing(getRequestTiming(reply));
+
+	if (timing)
+	{
+		if (timing->responseTime < 0)
+		{
+			timing->responseTime = QDateTime::currentMSecsSinceEpoch();
+		}
+
+		timing->bytesReceived = bytesReceived;
+	}
+
 	const QUrl url(reply->url());
 
 	if (url.isValid() && url.scheme() != QLatin1String("data"))
 	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Receiving data from %1…").arg(Utils::extractHost(reply->url())));
+		setLoadingMessage(ReceivingDataLoadingMessage, Utils::extractHost(url));
 	}
 
 	const qint64 difference(bytesReceived - m_replies[reply].first);
@@ -206,7 +327,9 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 	{
 		m_replies[reply].second = true;
 
-		m_pageInformation[WebWidget::TotalBytesTotalInformation] = (m_pageInformation[WebWidget::TotalBytesTotalInformation].toLongLong() + bytesTotal);
+		m_pageStatistics.totalBytesTotal += bytesTotal;
+
+		markPageInformationAsChanged(WebWidget::TotalBytesTotalInformation);
 	}
 
 	if (difference <= 0)
@@ -215,8 +338,9 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 	}
 
 	m_bytesReceivedDifference += difference;
+	m_pageStatistics.totalBytesReceived += difference;
 
-	setPageInformation(WebWidget::TotalBytesReceivedInformation, (m_pageInformation[WebWidget::TotalBytesReceivedInformation].toLongLong() + difference));
+	markPageInformationAsChanged(WebWidget::TotalBytesReceivedInformation);
 }
 
 void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
@@ -227,10 +351,28 @@ void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
 	}
 
 	const QUrl url(reply->url());
+	NetworkManager::RequestTiming *timing(getRequestTiming(reply));
+
+	if (timing)
+	{
+		timing->finishedTime = QDateTime::currentMSecsSinceEpoch();
+		timing->mimeType = reply->header(QNetworkRequest::ContentTypeHeader).toString().section(QLatin1Char(';'), 0, 0).trimmed();
+		timing->statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+		timing->isCached = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+		timing->isEncrypted = reply->attribute(QNetworkRequest::ConnectionEncryptedAttribute).toBool();
+
+		if (timing->responseTime < 0)
+		{
+			timing->responseTime = timing->finishedTime;
+		}
+	}
 
 	m_replies.remove(reply);
+	m_requestTimingIdentifiers.remove(reply);
+
+	++m_pageStatistics.requestsFinished;
 
-	setPageInformation(WebWidget::RequestsFinishedInformation, (m_pageInformation[WebWidget::RequestsFinishedInformation].toInt() + 1));
+	markPageInformationAsChanged(WebWidget::RequestsFinishedInformation);
 
 	if (reply == m_baseReply)
 	{
@@ -267,7 +409,7 @@ void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
 
 	if (url.isValid() && url.scheme() != QLatin1String("data"))
 	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Completed request to %1").arg(Utils::extractHost(url)));
+		setLoadingMessage(CompletedRequestLoadingMessage, Utils::extractHost(url));
 	}
 
 	disconnect(reply, &QNetworkReply::downloadProgress, this, &QtWebKitNetworkManager::handleDownloadProgress);
@@ -428,6 +570,44 @@ void QtWebKitNetworkManager::updateLoadingSpeed()
 	m_bytesReceivedDifference = 0;
 }
 
+void QtWebKitNetworkManager::startScheduledRequests()
+{
+	for (int i = 0; i < m_scheduledReplies.count(); ++i)
+	{
+		QtWebKitScheduledNetworkReply *reply(m_scheduledReplies.at(i));
+		QtWebKitNetworkManager *manager(reply ? qobject_cast<QtWebKitNetworkManager*>(reply->parent()) : nullptr);
+
+		if (!manager || reply->isFinished())
+		{
+			m_scheduledReplies.removeAt(i);
+
+			--i;
+		}
+		else if (manager->canStartRequest(reply->url().host()))
+		{
+			QNetworkRequest request(reply->request());
+
+			if (!manager->isBackground())
+			{
+				request.setPriority(QNetworkRequest::NormalPriority);
+			}
+
+			m_scheduledReplies.removeAt(i);
+
+			--i;
+
+			reply->setReply(manager->startRequest(reply->operation(), request, reply->getOutgoingData()));
+
+			NetworkManager::RequestTiming *timing(manager->getRequestTiming(reply));
+
+			if (timing)
+			{
+				timing->startedTime = QDateTime::currentMSecsSinceEpoch();
+			}
+		}
+	}
+}
+
 void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 {
 	if (!m_backend)
@@ -528,10 +708,41 @@ void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 	}
 }
 
+void QtWebKitNetworkManager::markPageInformationAsChanged(WebWidget::PageInformation key)
+{
+	if (!m_changedPageInformation.contains(key))
+	{
+		m_changedPageInformation.append(key);
+	}
+
+	if (m_pageInformationTimer == 0)
+	{
+		m_pageInformationTimer = startTimer(100);
+	}
+}
+
+void QtWebKitNetworkManager::setLoadingMessage(LoadingMessage message, const QString &host)
+{
+	if (m_loadingSpeedTimer != 0)
+	{
+		m_pageStatistics.loadingMessage = message;
+		m_pageStatistics.host = host;
+
+		markPageInformationAsChanged(WebWidget::LoadingMessageInformation);
+	}
+}
+
 void QtWebKitNetworkManager::setPageInformation(WebWidget::PageInformation key, const QVariant &value)
 {
 	if (m_loadingSpeedTimer != 0 || key != WebWidget::LoadingMessageInformation)
 	{
+		if (key == WebWidget::LoadingMessageInformation)
+		{
+			m_pageStatistics.loadingMessage = NoLoadingMessage;
+
+			m_changedPageInformation.removeAll(key);
+		}
+
 		m_pageInformation[key] = value;
 
 		emit pageInformationChanged(key, value);
@@ -567,6 +778,8 @@ QtWebKitNetworkManager* QtWebKitNetworkManager::clone() const
 
 QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
 {
+	NetworkManagerFactory::notifyRequestStarted(request.url(), this);
+
 	if (m_widget && request.url() == m_formRequestUrl)
 	{
 		m_formRequestUrl = QUrl();
@@ -646,11 +859,12 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 		return QNetworkAccessManager::createRequest(GetOperation, QNetworkRequest(QUrl()));
 	}
 
+	const NetworkManager::ResourceType resourceType(m_widget ? NetworkManager::getResourceType(request, m_mainRequestUrl) : NetworkManager::OtherType);
+
 	if (m_widget && (m_contentBlockingExceptions.isEmpty() || !m_contentBlockingExceptions.contains(request.url())))
 	{
 		const QUrl baseUrl(m_widget->isNavigating() ? request.url() : m_widget->getUrl());
 		const bool needsContentBlockingCheck(!m_contentBlockingProfiles.isEmpty() && (m_unblockedHosts.isEmpty() || !m_unblockedHosts.contains(Utils::extractHost(baseUrl))));
-		const NetworkManager::ResourceType resourceType((needsContentBlockingCheck || !m_areImagesEnabled) ? NetworkManager::getResourceType(request, m_mainRequestUrl) : NetworkManager::OtherType);
 
 		if (!m_areImagesEnabled && request.url() != m_mainRequestUrl && resourceType == NetworkManager::ImageType)
 		{
@@ -680,6 +894,17 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 
 				m_blockedRequests.append(resource);
 
+				NetworkManager::RequestTiming timing;
+				timing.url = request.url();
+				timing.method = getMethod(operation, request);
+				timing.rule = result.rule;
+				timing.queuedTime = QDateTime::currentMSecsSinceEpoch();
+				timing.finishedTime = timing.queuedTime;
+				timing.resourceType = resourceType;
+				timing.isBlocked = true;
+
+				addRequestTiming(timing);
+
 				emit requestBlocked(resource);
 
 				return QNetworkAccessManager::createRequest(GetOperation, QNetworkRequest());
@@ -687,7 +912,9 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 		}
 	}
 
-	setPageInformation(WebWidget::RequestsStartedInformation, (m_pageInformation[WebWidget::RequestsStartedInformation].toULongLong() + 1));
+	++m_pageStatistics.requestsStarted;
+
+	markPageInformationAsChanged(WebWidget::RequestsStartedInformation);
 
 	QNetworkRequest mutableRequest(request);
 
@@ -716,7 +943,40 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 	mutableRequest.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
 #endif
 
-	setPageInformation(WebWidget::LoadingMessageInformation, tr("Sending request to %1…").arg(request.url().host()));
+	const bool isBackgroundRequest(isBackground());
+	bool canSchedule(false);
+
+	switch (resourceType)
+	{
+		case NetworkManager::MainFrameType:
+		case NetworkManager::SubFrameType:
+		case NetworkManager::StyleSheetType:
+		case NetworkManager::ScriptType:
+			mutableRequest.setPriority(isBackgroundRequest ? QNetworkRequest::NormalPriority : QNetworkRequest::HighPriority);
+
+			break;
+		case NetworkManager::ImageType:
+		case NetworkManager::XmlHttpRequestType:
+			if (isBackgroundRequest)
+			{
+				mutableRequest.setPriority(QNetworkRequest::LowPriority);
+
+				canSchedule = (operation == GetOperation && request.url() != m_mainRequestUrl && (request.url().scheme() == QLatin1String("http") || request.url().scheme() == QLatin1String("https")));
+			}
+
+			break;
+		default:
+			break;
+	}
+
+	setLoadingMessage(SendingRequestLoadingMessage, request.url().host());
+
+	NetworkManager::RequestTiming timing;
+	timing.url = request.url();
+	timing.method = getMethod(operation, request);
+	timing.queuedTime = QDateTime::currentMSecsSinceEpoch();
+	timing.startedTime = timing.queuedTime;
+	timing.resourceType = resourceType;
 
 	QNetworkReply *reply(nullptr);
 
@@ -756,11 +1016,28 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 			}
 		}
 	}
+	else if (canSchedule && !canStartRequest(request.url().host()))
+	{
+		QtWebKitScheduledNetworkReply *scheduledReply(new QtWebKitScheduledNetworkReply(operation, mutableRequest, outgoingData, this));
+
+		reply = scheduledReply;
+
+		timing.startedTime = -1;
+
+		connect(scheduledReply, &QtWebKitScheduledNetworkReply::finished, this, [=]()
+		{
+			handleRequestFinished(scheduledReply);
+		});
+
+		m_scheduledReplies.append(scheduledReply);
+	}
 	else
 	{
-		reply = QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
+		reply = startRequest(operation, mutableRequest, outgoingData);
 	}
 
+	m_requestTimingIdentifiers[reply] = addRequestTiming(timing);
+
 	if (!m_baseReply && request.url() == m_mainRequestUrl)
 	{
 		m_baseReply = reply;
@@ -799,6 +1076,34 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 	return reply;
 }
 
+QNetworkReply* QtWebKitNetworkManager::startRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
+{
+	QNetworkReply *reply(QNetworkAccessManager::createRequest(operation, request, outgoingData));
+	RequestInformation information;
+	information.host = request.url().host();
+	information.isBackground = (isBackground() && request.priority() == QNetworkRequest::LowPriority);
+
+	m_requests[reply] = information;
+
+	++m_hostRequests[information.host];
+
+	if (information.isBackground)
+	{
+		++m_backgroundRequests;
+	}
+
+	connect(reply, &QNetworkReply::finished, this, [=]()
+	{
+		finishRequest(reply);
+	});
+	connect(reply, &QNetworkReply::destroyed, this, [=]()
+	{
+		finishRequest(reply);
+	});
+
+	return reply;
+}
+
 CookieJar* QtWebKitNetworkManager::getCookieJar() const
 {
 	return m_cookieJar;
@@ -809,6 +1114,29 @@ QString QtWebKitNetworkManager::getUserAgent() const
 	return m_userAgent;
 }
 
+QString QtWebKitNetworkManager::getMethod(Operation operation, const QNetworkRequest &request)
+{
+	switch (operation)
+	{
+		case HeadOperation:
+			return QLatin1String("HEAD");
+		case GetOperation:
+			return QLatin1String("GET");
+		case PutOperation:
+			return QLatin1String("PUT");
+		case PostOperation:
+			return QLatin1String("POST");
+		case DeleteOperation:
+			return QLatin1String("DELETE");
+		case CustomOperation:
+			return QString::fromLatin1(request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray());
+		default:
+			break;
+	}
+
+	return {};
+}
+
 QVariant QtWebKitNetworkManager::getOption(int identifier, const QUrl &url) const
 {
 	return (m_widget ? m_widget->getOption(identifier, url) : SettingsManager::getOption(identifier, Utils::extractHost(url)));
@@ -816,9 +1144,40 @@ QVariant QtWebKitNetworkManager::getOption(int identifier, const QUrl &url) cons
 
 QVariant QtWebKitNetworkManager::getPageInformation(WebWidget::PageInformation key) const
 {
-	if (key == WebWidget::RequestsBlockedInformation)
+	switch (key)
 	{
-		return m_blockedRequests.count();
+		case WebWidget::DocumentBytesReceivedInformation:
+			return m_pageStatistics.documentBytesReceived;
+		case WebWidget::DocumentBytesTotalInformation:
+			return m_pageStatistics.documentBytesTotal;
+		case WebWidget::DocumentLoadingProgressInformation:
+			return m_pageStatistics.documentLoadingProgress;
+		case WebWidget::TotalBytesReceivedInformation:
+			return m_pageStatistics.totalBytesReceived;
+		case WebWidget::TotalBytesTotalInformation:
+			return m_pageStatistics.totalBytesTotal;
+		case WebWidget::RequestsBlockedInformation:
+			return m_blockedRequests.count();
+		case WebWidget::RequestsFinishedInformation:
+			return m_pageStatistics.requestsFinished;
+		case WebWidget::RequestsStartedInformation:
+			return m_pageStatistics.requestsStarted;
+		case WebWidget::LoadingMessageInformation:
+			switch (m_pageStatistics.loadingMessage)
+			{
+				case SendingRequestLoadingMessage:
+					return tr("Sending request to %1…").arg(m_pageStatistics.host);
+				case ReceivingDataLoadingMessage:
+					return tr("Receiving data from %1…").arg(m_pageStatistics.host);
+				case CompletedRequestLoadingMessage:
+					return tr("Completed request to %1").arg(m_pageStatistics.host);
+				default:
+					break;
+			}
+
+			break;
+		default:
+			break;
 	}
 
 	return m_pageInformation.value(key);
@@ -839,6 +1198,37 @@ QVector<NetworkManager::ResourceInformation> QtWebKitNetworkManager::getBlockedR
 	return m_blockedRequests;
 }
 
+QVector<NetworkManager::RequestTiming> QtWebKitNetworkManager::getRequestTimings() const
+{
+	if (m_requestTimings.count() < REQUEST_TIMINGS_LIMIT)
+	{
+		return m_requestTimings;
+	}
+
+	const int index(static_cast<int>(m_requestTimingIdentifier % REQUEST_TIMINGS_LIMIT));
+
+	return (m_requestTimings.mid(index) + m_requestTimings.mid(0, index));
+}
+
+NetworkManager::RequestTiming* QtWebKitNetworkManager::getRequestTiming(QNetworkReply *reply)
+{
+	const quint64 identifier(m_requestTimingIdentifiers.value(reply, 0));
+
+	if (identifier == 0)
+	{
+		return nullptr;
+	}
+
+	const int index(static_cast<int>((identifier - 1) % REQUEST_TIMINGS_LIMIT));
+
+	if (index < m_requestTimings.count() && m_requestTimings.at(index).identifier == identifier)
+	{
+		return &m_requestTimings[index];
+	}
+
+	return nullptr;
+}
+
 QMap<QByteArray, QByteArray> QtWebKitNetworkManager::getHeaders() const
 {
 	return m_headers;
@@ -849,4 +1239,14 @@ WebWidget::ContentStates QtWebKitNetworkManager::getContentState() const
 	return m_contentState;
 }
 
+bool QtWebKitNetworkManager::canStartRequest(const QString &host) const
+{
+	return (!isBackground() || (m_backgroundRequests < BACKGROUND_TAB_REQUESTS_LIMIT && m_hostRequests.value(host) < HOST_REQUESTS_LIMIT));
+}
+
+bool QtWebKitNetworkManager::isBackground() const
+{
+	return (m_widget && !m_widget->isVisible());
+}
+
 }
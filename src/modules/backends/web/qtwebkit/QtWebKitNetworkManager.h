@@ -33,6 +33,7 @@ namespace Otter
 
 class NetworkProxyFactory;
 class QtWebKitCookieJar;
+class QtWebKitScheduledNetworkReply;
 class WebBackend;
 
 class QtWebKitNetworkManager final : public QNetworkAccessManager
@@ -41,30 +42,69 @@ class QtWebKitNetworkManager final : public QNetworkAccessManager
 
 public:
 	explicit QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar *cookieJarProxy, QtWebKitWebWidget *parent);
+	~QtWebKitNetworkManager();
 
 	CookieJar* getCookieJar() const;
 	QVariant getPageInformation(WebWidget::PageInformation key) const;
 	WebWidget::SslInformation getSslInformation() const;
 	QStringList getBlockedElements() const;
 	QVector<NetworkManager::ResourceInformation> getBlockedRequests() const;
+	QVector<NetworkManager::RequestTiming> getRequestTimings() const;
 	QMap<QByteArray, QByteArray> getHeaders() const;
 	WebWidget::ContentStates getContentState() const;
 
 protected:
+	enum LoadingMessage
+	{
+		NoLoadingMessage = 0,
+		SendingRequestLoadingMessage,
+		ReceivingDataLoadingMessage,
+		CompletedRequestLoadingMessage
+	};
+
+	struct PageStatistics final
+	{
+		QString host;
+		qint64 documentBytesReceived = 0;
+		qint64 documentBytesTotal = 0;
+		qint64 totalBytesReceived = 0;
+		qint64 totalBytesTotal = 0;
+		int documentLoadingProgress = -1;
+		int requestsFinished = 0;
+		int requestsStarted = 0;
+		LoadingMessage loadingMessage = NoLoadingMessage;
+	};
+
+	struct RequestInformation final
+	{
+		QString host;
+		bool isBackground = false;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
 	void addContentBlockingException(const QUrl &url, NetworkManager::ResourceType resourceType);
 	void resetStatistics();
 	void registerTransfer(QNetworkReply *reply);
+	void finishRequest(QObject *reply);
+	quint64 addRequestTiming(NetworkManager::RequestTiming timing);
 	void updateLoadingSpeed();
 	void updateOptions(const QUrl &url);
+	void markPageInformationAsChanged(WebWidget::PageInformation key);
+	void setLoadingMessage(LoadingMessage message, const QString &host);
 	void setPageInformation(WebWidget::PageInformation key, const QVariant &value);
 	void setFormRequest(const QUrl &url);
 	void setMainRequest(const QUrl &url);
 	void setWidget(QtWebKitWebWidget *widget);
 	QtWebKitNetworkManager* clone() const;
 	QNetworkReply* createRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData) override;
+	QNetworkReply* startRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData);
 	QString getUserAgent() const;
 	QVariant getOption(int identifier, const QUrl &url) const;
+	NetworkManager::RequestTiming* getRequestTiming(QNetworkReply *reply);
+	bool canStartRequest(const QString &host) const;
+	bool isBackground() const;
+	static QString getMethod(Operation operation, const QNetworkRequest &request);
+	static void startScheduledRequests();
 
 protected slots:
 	void handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
@@ -93,17 +133,27 @@ private:
 	QVector<int> m_contentBlockingProfiles;
 	QSet<QUrl> m_contentBlockingExceptions;
 	QHash<QNetworkReply*, QPair<qint64, bool> > m_replies;
+	QHash<QObject*, RequestInformation> m_requests;
+	QHash<QNetworkReply*, quint64> m_requestTimingIdentifiers;
+	QVector<NetworkManager::RequestTiming> m_requestTimings;
 	QMap<QByteArray, QByteArray> m_headers;
 	QMap<WebWidget::PageInformation, QVariant> m_pageInformation;
+	QVector<WebWidget::PageInformation> m_changedPageInformation;
+	PageStatistics m_pageStatistics;
 	WebWidget::ContentStates m_contentState;
 	NetworkManagerFactory::DoNotTrackPolicy m_doNotTrackPolicy;
 	TrileanValue m_isSecureValue;
 	qint64 m_bytesReceivedDifference;
+	quint64 m_requestTimingIdentifier;
 	int m_loadingSpeedTimer;
+	int m_pageInformationTimer;
+	int m_backgroundRequests;
 	bool m_areImagesEnabled;
 	bool m_canSendReferrer;
 
 	static WebBackend *m_backend;
+	static QVector<QPointer<QtWebKitScheduledNetworkReply> > m_scheduledReplies;
+	static QHash<QString, int> m_hostRequests;
 
 signals:
 	void pageInformationChanged(WebWidget::PageInformation, const QVariant &value);
@@ -0,0 +1,180 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2020 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "QtWebKitScheduledNetworkReply.h"
+
+#include <QtCore/QCoreApplication>
+
+namespace Otter
+{
+
+QtWebKitScheduledNetworkReply::QtWebKitScheduledNetworkReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QIODevice *outgoingData, QObject *parent) : QNetworkReply(parent),
+	m_outgoingData(outgoingData)
+{
+	setOperation(operation);
+	setRequest(request);
+	setUrl(request.url());
+	open(ReadOnly | Unbuffered);
+}
+
+void QtWebKitScheduledNetworkReply::abort()
+{
+	if (m_reply)
+	{
+		m_reply->abort();
+
+		return;
+	}
+
+	if (isFinished())
+	{
+		return;
+	}
+
+	setError(OperationCanceledError, QCoreApplication::translate("QNetworkReply", "Operation canceled"));
+	setFinished(true);
+
+	emit error(OperationCanceledError);
+	emit finished();
+}
+
+void QtWebKitScheduledNetworkReply::ignoreSslErrors()
+{
+	if (m_reply)
+	{
+		m_reply->ignoreSslErrors();
+	}
+}
+
+void QtWebKitScheduledNetworkReply::ignoreSslErrorsImplementation(const QList<QSslError> &errors)
+{
+	if (m_reply)
+	{
+		m_reply->ignoreSslErrors(errors);
+	}
+}
+
+#ifndef QT_NO_SSL
+void QtWebKitScheduledNetworkReply::setSslConfigurationImplementation(const QSslConfiguration &configuration)
+{
+	if (m_reply)
+	{
+		m_reply->setSslConfiguration(configuration);
+	}
+}
+
+void QtWebKitScheduledNetworkReply::sslConfigurationImplementation(QSslConfiguration &configuration) const
+{
+	if (m_reply)
+	{
+		configuration = m_reply->sslConfiguration();
+	}
+}
+#endif
+
+void QtWebKitScheduledNetworkReply::handleError(NetworkError code)
+{
+	setError(code, m_reply->errorString());
+
+	emit error(code);
+}
+
+void QtWebKitScheduledNetworkReply::handleFinished()
+{
+	handleMetaDataChanged();
+	setFinished(true);
+
+	emit finished();
+}
+
+void QtWebKitScheduledNetworkReply::handleMetaDataChanged()
+{
+	const QList<RawHeaderPair> headers(m_reply->rawHeaderPairs());
+
+	for (int i = 0; i < headers.count(); ++i)
+	{
+		setRawHeader(headers.at(i).first, headers.at(i).second);
+	}
+
+	const QVector<QNetworkRequest::Attribute> attributes({QNetworkRequest::HttpStatusCodeAttribute, QNetworkRequest::HttpReasonPhraseAttribute, QNetworkRequest::RedirectionTargetAttribute, QNetworkRequest::ConnectionEncryptedAttribute, QNetworkRequest::SourceIsFromCacheAttribute, QNetworkRequest::HttpPipeliningWasUsedAttribute});
+
+	for (int i = 0; i < attributes.count(); ++i)
+	{
+		setAttribute(attributes.at(i), m_reply->attribute(attributes.at(i)));
+	}
+
+	setUrl(m_reply->url());
+}
+
+void QtWebKitScheduledNetworkReply::setReply(QNetworkReply *reply)
+{
+	m_reply = reply;
+	m_reply->setParent(this);
+
+	connect(m_reply, &QNetworkReply::metaDataChanged, this, [&]()
+	{
+		handleMetaDataChanged();
+
+		emit metaDataChanged();
+	});
+	connect(m_reply, &QNetworkReply::readyRead, this, &QtWebKitScheduledNetworkReply::readyRead);
+	connect(m_reply, &QNetworkReply::downloadProgress, this, &QtWebKitScheduledNetworkReply::downloadProgress);
+	connect(m_reply, &QNetworkReply::uploadProgress, this, &QtWebKitScheduledNetworkReply::uploadProgress);
+	connect(m_reply, &QNetworkReply::redirected, this, &QtWebKitScheduledNetworkReply::redirected);
+	connect(m_reply, &QNetworkReply::finished, this, &QtWebKitScheduledNetworkReply::handleFinished);
+	connect(m_reply, static_cast<void(QNetworkReply::*)(QNetworkReply::NetworkError)>(&QNetworkReply::error), this, &QtWebKitScheduledNetworkReply::handleError);
+#ifndef QT_NO_SSL
+	connect(m_reply, &QNetworkReply::encrypted, this, &QtWebKitScheduledNetworkReply::encrypted);
+	connect(m_reply, &QNetworkReply::sslErrors, this, &QtWebKitScheduledNetworkReply::sslErrors);
+#endif
+}
+
+QIODevice* QtWebKitScheduledNetworkReply::getOutgoingData() const
+{
+	return m_outgoingData.data();
+}
+
+qint64 QtWebKitScheduledNetworkReply::readData(char *data, qint64 maxSize)
+{
+	if (!m_reply)
+	{
+		return (isFinished() ? -1 : 0);
+	}
+
+	const qint64 amount(m_reply->read(data, maxSize));
+
+	return ((amount == 0 && isFinished()) ? -1 : amount);
+}
+
+qint64 QtWebKitScheduledNetworkReply::bytesAvailable() const
+{
+	return (QNetworkReply::bytesAvailable() + (m_reply ? m_reply->bytesAvailable() : 0));
+}
+
+bool QtWebKitScheduledNetworkReply::isSequential() const
+{
+	return true;
+}
+
+bool QtWebKitScheduledNetworkReply::isStarted() const
+{
+	return !m_reply.isNull();
+}
+
+}
@@ -0,0 +1,67 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2020 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_QTWEBKITSCHEDULEDNETWORKREPLY_H
+#define OTTER_QTWEBKITSCHEDULEDNETWORKREPLY_H
+
+#include <QtCore/QPointer>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+namespace Otter
+{
+
+class QtWebKitScheduledNetworkReply final : public QNetworkReply
+{
+	Q_OBJECT
+
+public:
+	explicit QtWebKitScheduledNetworkReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QIODevice *outgoingData, QObject *parent);
+
+	void setReply(QNetworkReply *reply);
+	QIODevice* getOutgoingData() const;
+	qint64 bytesAvailable() const override;
+	bool isSequential() const override;
+	bool isStarted() const;
+
+public slots:
+	void abort() override;
+	void ignoreSslErrors() override;
+
+protected:
+	void ignoreSslErrorsImplementation(const QList<QSslError> &errors) override;
+#ifndef QT_NO_SSL
+	void setSslConfigurationImplementation(const QSslConfiguration &configuration) override;
+	void sslConfigurationImplementation(QSslConfiguration &configuration) const override;
+#endif
+	qint64 readData(char *data, qint64 maxSize) override;
+
+protected slots:
+	void handleError(NetworkError code);
+	void handleFinished();
+	void handleMetaDataChanged();
+
+private:
+	QPointer<QNetworkReply> m_reply;
+	QPointer<QIODevice> m_outgoingData;
+};
+
+}
+
+#endif
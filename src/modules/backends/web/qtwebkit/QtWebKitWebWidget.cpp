@@ -153,6 +153,13 @@ QtWebKitWebWidget::QtWebKitWebWidget(const QVariantMap &parameters, WebBackend *
 	connect(m_page, &QtWebKitPage::downloadRequested, this, &QtWebKitWebWidget::handleDownloadRequested);
 	connect(m_page, &QtWebKitPage::unsupportedContent, this, &QtWebKitWebWidget::handleUnsupportedContent);
 	connect(m_page, &QtWebKitPage::linkHovered, this, &QtWebKitWebWidget::setStatusMessageOverride);
+	connect(m_page, &QtWebKitPage::linkHovered, this, [&](const QString &link)
+	{
+		if (!link.isEmpty() && !isPrivate())
+		{
+			NetworkManagerFactory::preconnect(QUrl(link), m_networkManager);
+		}
+	});
 	connect(m_page, &QtWebKitPage::microFocusChanged, [&]()
 	{
 		emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::EditingCategory});
@@ -230,6 +237,8 @@ void QtWebKitWebWidget::showEvent(QShowEvent *event)
 	WebWidget::showEvent(event);
 
 	m_page->setVisibilityState(QWebPage::VisibilityStateVisible);
+
+	QtWebKitNetworkManager::startScheduledRequests();
 }
 
 void QtWebKitWebWidget::hideEvent(QHideEvent *event)
@@ -1531,7 +1540,6 @@ void QtWebKitWebWidget::handleHistory()
 			m_isTypedIn = false;
 		}
 
-		SessionsManager::markSessionAsModified();
 		BookmarksManager::updateVisits(url.toString());
 	}
 }
@@ -1618,8 +1626,6 @@ void QtWebKitWebWidget::notifyUrlChanged(const QUrl &url)
 	emit urlChanged(url);
 	emit arbitraryActionsStateChanged({ActionsManager::InspectPageAction, ActionsManager::InspectElementAction});
 	emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::NavigationCategory, ActionsManager::ActionDefinition::PageCategory});
-
-	SessionsManager::markSessionAsModified();
 }
 
 void QtWebKitWebWidget::notifyIconChanged()
@@ -2538,6 +2544,11 @@ QVector<NetworkManager::ResourceInformation> QtWebKitWebWidget::getBlockedReques
 	return m_networkManager->getBlockedRequests();
 }
 
+QVector<NetworkManager::RequestTiming> QtWebKitWebWidget::getRequestTimings() const
+{
+	return m_networkManager->getRequestTimings();
+}
+
 QMap<QByteArray, QByteArray> QtWebKitWebWidget::getHeaders() const
 {
 	return m_networkManager->getHeaders();
@@ -2577,6 +2588,28 @@ WebWidget::LoadingState QtWebKitWebWidget::getLoadingState() const
 	return m_loadingState;
 }
 
+qint64 QtWebKitWebWidget::getEstimatedMemoryUsage() const
+{
+	if (m_loadingState == DeferredLoadingState)
+	{
+		return 0;
+	}
+
+	qint64 usage(WebWidget::getEstimatedMemoryUsage());
+	QList<QWebFrame*> frames({m_page->mainFrame()});
+
+	while (!frames.isEmpty())
+	{
+		QWebFrame *frame(frames.takeLast());
+
+		usage += qMax(0LL, m_page->runScript(QLatin1String("getMemoryUsage"), frame->documentElement()).toLongLong());
+
+		frames.append(frame->childFrames());
+	}
+
+	return usage;
+}
+
 int QtWebKitWebWidget::getZoom() const
 {
 	return static_cast<int>(m_page->mainFrame()->zoomFactor() * 100);
@@ -83,10 +83,12 @@ public:
 	QVector<LinkUrl> getLinks() const override;
 	QVector<LinkUrl> getSearchEngines() const override;
 	QVector<NetworkManager::ResourceInformation> getBlockedRequests() const override;
+	QVector<NetworkManager::RequestTiming> getRequestTimings() const override;
 	QMap<QByteArray, QByteArray> getHeaders() const override;
 	QMultiMap<QString, QString> getMetaData() const override;
 	ContentStates getContentState() const override;
 	LoadingState getLoadingState() const override;
+	qint64 getEstimatedMemoryUsage() const override;
 	int getZoom() const override;
 	bool hasSelection() const override;
 	bool hasWatchedChanges(ChangeWatcher watcher) const override;
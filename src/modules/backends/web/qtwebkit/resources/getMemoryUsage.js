@@ -0,0 +1,18 @@
+(function(window)
+{
+	var usage = (document.getElementsByTagName('*').length * 256);
+	var images = document.images;
+	var canvases = document.getElementsByTagName('canvas');
+
+	for (var i = 0; i < images.length; ++i)
+	{
+		usage += (images[i].naturalWidth * images[i].naturalHeight * 4);
+	}
+
+	for (var i = 0; i < canvases.length; ++i)
+	{
+		usage += (canvases[i].width * canvases[i].height * 4);
+	}
+
+	return usage;
+})(window);
@@ -37,6 +37,7 @@
 #if QT_VERSION >= 0x050900
 #include <QtCore/QOperatingSystemVersion>
 #endif
+#include <QtCore/QSettings>
 #include <QtCore/QTemporaryDir>
 #include <QtCore/QtMath>
 #include <QtGui/QDesktopServices>
@@ -27,16 +27,23 @@
 #include "../../../core/ThemesManager.h"
 #include "../../../core/Utils.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QDir>
-#include <QtCore/QFileInfo>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QMimeDatabase>
 #include <QtWidgets/QFileIconProvider>
 
+#define LOCAL_PATHS_COMPLETION_LIMIT 500
+#define LOCAL_PATHS_COMPLETION_TIME_LIMIT 250
+
 namespace Otter
 {
 
 AddressCompletionModel::AddressCompletionModel(QObject *parent) : QAbstractListModel(parent),
 	m_types(NoCompletionType),
+	m_generation(0),
 	m_updateTimer(0),
 	m_showCompletionCategories(true)
 {
@@ -64,6 +71,8 @@ void AddressCompletionModel::updateModel()
 	QVector<CompletionEntry> completions;
 	completions.reserve(10);
 
+	++m_generation;
+
 	if (m_types.testFlag(SearchSuggestionsCompletionType))
 	{
 		const QString keyword(m_filter.section(QLatin1Char(' '), 0, 0));
@@ -129,27 +138,21 @@ void AddressCompletionModel::updateModel()
 	{
 		const QString directory((m_filter == QString(QLatin1Char('~'))) ? QDir::homePath() : m_filter.section(QDir::separator(), 0, -2) + QDir::separator());
 		const QString prefix(m_filter.contains(QDir::separator()) ? m_filter.section(QDir::separator(), -1, -1) : QString());
-		const QList<QFileInfo> entries(QDir(Utils::normalizePath(directory)).entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot));
-		const QFileIconProvider iconProvider;
-		const QMimeDatabase mimeDatabase;
-		bool headerWasAdded(!m_showCompletionCategories);
+		const quint64 generation(m_generation);
+		const int row(completions.count());
+		QFutureWatcher<QVector<LocalPathEntry> > *watcher(new QFutureWatcher<QVector<LocalPathEntry> >(this));
 
-		for (int i = 0; i < entries.count(); ++i)
+		connect(watcher, &QFutureWatcher<QVector<LocalPathEntry> >::finished, this, [=]()
 		{
-			if (entries.at(i).fileName().startsWith(prefix, Qt::CaseInsensitive))
+			if (generation == m_generation)
 			{
-				const QString path(directory + entries.at(i).fileName());
-
-				if (!headerWasAdded)
-				{
-					completions.append(CompletionEntry({}, tr("Local files"), {}, {}, {}, CompletionEntry::HeaderType));
+				insertLocalPaths(watcher->result(), row);
+			}
 
-					headerWasAdded = true;
-				}
+			watcher->deleteLater();
+		});
 
-				completions.append(CompletionEntry(QUrl::fromLocalFile(QDir::toNativeSeparators(path)), path, path, QIcon::fromTheme(mimeDatabase.mimeTypeForFile(entries.at(i), QMimeDatabase::MatchExtension).iconName(), iconProvider.icon(entries.at(i))), {}, CompletionEntry::LocalPathType));
-			}
-		}
+		watcher->setFuture(QtConcurrent::run(&AddressCompletionModel::findLocalPaths, directory, Utils::normalizePath(directory), prefix));
 	}
 
 	if (m_types.testFlag(HistoryCompletionType))
@@ -214,6 +217,45 @@ void AddressCompletionModel::updateModel()
 	endResetModel();
 }
 
+void AddressCompletionModel::insertLocalPaths(const QVector<LocalPathEntry> &entries, int row)
+{
+	if (entries.isEmpty())
+	{
+		return;
+	}
+
+	const QFileIconProvider iconProvider;
+	const QIcon directoryIcon(iconProvider.icon(QFileIconProvider::Folder));
+	const QIcon fileIcon(iconProvider.icon(QFileIconProvider::File));
+	QVector<CompletionEntry> completions;
+	completions.reserve(entries.count() + 1);
+
+	if (m_showCompletionCategories)
+	{
+		completions.append(CompletionEntry({}, tr("Local files"), {}, {}, {}, CompletionEntry::HeaderType));
+	}
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		const QString path(entries.at(i).path);
+
+		completions.append(CompletionEntry(QUrl::fromLocalFile(QDir::toNativeSeparators(path)), path, path, QIcon::fromTheme(entries.at(i).iconName, (entries.at(i).information.isDir() ? directoryIcon : fileIcon)), {}, CompletionEntry::LocalPathType));
+	}
+
+	row = qMin(row, m_completions.count());
+
+	beginInsertRows({}, row, (row + completions.count() - 1));
+
+	for (int i = 0; i < completions.count(); ++i)
+	{
+		m_completions.insert((row + i), completions.at(i));
+	}
+
+	endInsertRows();
+
+	emit completionReady(m_filter);
+}
+
 void AddressCompletionModel::setFilter(const QString &filter)
 {
 	m_filter = filter;
@@ -228,6 +270,8 @@ void AddressCompletionModel::setFilter(const QString &filter)
 			m_updateTimer = 0;
 		}
 
+		++m_generation;
+
 		beginResetModel();
 
 		m_completions.clear();
@@ -262,6 +306,40 @@ void AddressCompletionModel::setTypes(CompletionTypes types, bool force)
 	}
 }
 
+QVector<AddressCompletionModel::LocalPathEntry> AddressCompletionModel::findLocalPaths(const QString &directory, const QString &normalizedDirectory, const QString &prefix)
+{
+	const QMimeDatabase mimeDatabase;
+	QVector<LocalPathEntry> entries;
+	QElapsedTimer timer;
+	timer.start();
+
+	QDirIterator iterator(normalizedDirectory, (QDir::AllEntries | QDir::NoDotAndDotDot));
+
+	while (iterator.hasNext() && entries.count() < LOCAL_PATHS_COMPLETION_LIMIT && !timer.hasExpired(LOCAL_PATHS_COMPLETION_TIME_LIMIT))
+	{
+		iterator.next();
+
+		const QFileInfo information(iterator.fileInfo());
+
+		if (information.fileName().startsWith(prefix, Qt::CaseInsensitive))
+		{
+			LocalPathEntry entry;
+			entry.information = information;
+			entry.path = directory + information.fileName();
+			entry.iconName = mimeDatabase.mimeTypeForFile(information, QMimeDatabase::MatchExtension).iconName();
+
+			entries.append(entry);
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(), [&](const LocalPathEntry &first, const LocalPathEntry &second)
+	{
+		return (first.information.fileName().compare(second.information.fileName(), Qt::CaseInsensitive) < 0);
+	});
+
+	return entries;
+}
+
 QVariant AddressCompletionModel::data(const QModelIndex &index, int role) const
 {
 	if (index.column() == 0 && index.row() >= 0 && index.row() < m_completions.count())
@@ -25,6 +25,7 @@
 #include "../../../core/SearchEnginesManager.h"
 
 #include <QtCore/QAbstractListModel>
+#include <QtCore/QFileInfo>
 #include <QtCore/QUrl>
 
 namespace Otter
@@ -105,14 +106,24 @@ public slots:
 	void setFilter(const QString &filter = {});
 
 protected:
+	struct LocalPathEntry final
+	{
+		QFileInfo information;
+		QString path;
+		QString iconName;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
 	void updateModel();
+	void insertLocalPaths(const QVector<LocalPathEntry> &entries, int row);
+	static QVector<LocalPathEntry> findLocalPaths(const QString &directory, const QString &normalizedDirectory, const QString &prefix);
 
 private:
 	QVector<CompletionEntry> m_completions;
 	QString m_filter;
 	SearchEnginesManager::SearchEngineDefinition m_defaultSearchEngine;
 	AddressCompletionModel::CompletionTypes m_types;
+	quint64 m_generation;
 	int m_updateTimer;
 	bool m_showCompletionCategories;
 
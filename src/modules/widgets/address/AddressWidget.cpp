@@ -27,6 +27,7 @@
 #include "../../../core/FeedsManager.h"
 #include "../../../core/InputInterpreter.h"
 #include "../../../core/HistoryManager.h"
+#include "../../../core/NetworkManagerFactory.h"
 #include "../../../core/SearchEnginesManager.h"
 #include "../../../core/ThemesManager.h"
 #include "../../../core/Utils.h"
@@ -328,9 +329,11 @@ AddressWidget::AddressWidget(Window *window, QWidget *parent) : LineEditWidget(p
 			updateCompletion(true, true);
 		}
 	});
-	connect(this, &AddressWidget::textEdited, this, [&]()
+	connect(this, &AddressWidget::textEdited, this, [&](const QString &text)
 	{
 		m_wasEdited = true;
+
+		InputInterpreter::prefetchHost(text);
 	});
 	connect(this, &AddressWidget::textDropped, this, [&](const QString &text)
 	{
@@ -945,9 +948,7 @@ void AddressWidget::handleUserInput(const QString &text, SessionsManager::OpenHi
 
 	if (!text.isEmpty())
 	{
-		const InputInterpreter::InterpreterResult result(InputInterpreter::interpret(text));
-
-		if (result.isValid())
+		InputInterpreter::interpret(text, InputInterpreter::NoFlags, this, [=](const InputInterpreter::InterpreterResult &result)
 		{
 			MainWindow *mainWindow(m_window ? MainWindow::findMainWindow(m_window) : MainWindow::findMainWindow(this));
 			ActionExecutor::Object executor(mainWindow, mainWindow);
@@ -975,7 +976,7 @@ void AddressWidget::handleUserInput(const QString &text, SessionsManager::OpenHi
 				default:
 					break;
 			}
-		}
+		});
 	}
 }
 
@@ -1342,6 +1343,21 @@ void AddressWidget::setCompletion(const QString &filter)
 		showCompletion(false);
 	}
 
+	if (!m_window || !m_window->isPrivate())
+	{
+		for (int i = 0; i < m_completionModel->rowCount(); ++i)
+		{
+			const QUrl url(m_completionModel->index(i).data(AddressCompletionModel::UrlRole).toUrl());
+
+			if (url.isValid())
+			{
+				NetworkManagerFactory::preconnect(url);
+
+				break;
+			}
+		}
+	}
+
 	if (m_completionModes.testFlag(InlineCompletionMode))
 	{
 		for (int i = 0; i < m_completionModel->rowCount(); ++i)
@@ -224,12 +224,16 @@ TransferActionWidget::TransferActionWidget(Transfer *transfer, QWidget *parent)
 		{
 			case Transfer::CancelledState:
 			case Transfer::ErrorState:
-				m_transfer->restart();
+				TransfersManager::restartTransfer(m_transfer);
 
 				break;
 			case Transfer::FinishedState:
 				Utils::runApplication({}, QUrl::fromLocalFile(QFileInfo(m_transfer->getTarget()).dir().canonicalPath()));
 
+				break;
+			case Transfer::QueuedState:
+				TransfersManager::startQueuedTransfer(m_transfer);
+
 				break;
 			default:
 				m_transfer->stop();
@@ -266,6 +270,10 @@ void TransferActionWidget::updateState()
 	{
 		detailsValues.append({tr("Size:"), tr("%1 (download completed)").arg(Utils::formatUnit(m_transfer->getBytesTotal()))});
 	}
+	else if (m_transfer->getState() == Transfer::QueuedState)
+	{
+		detailsValues.append({tr("Status:"), tr("Queued (%1)").arg(TransfersManager::getQueuePosition(m_transfer))});
+	}
 	else
 	{
 		detailsValues.append({tr("Size:"), tr("%1 (%2% downloaded)").arg(Utils::formatUnit(m_transfer->getBytesTotal())).arg(Utils::calculatePercent(m_transfer->getBytesReceived(), m_transfer->getBytesTotal()), 0, 'f', 1)});
@@ -281,13 +289,23 @@ void TransferActionWidget::updateState()
 		}
 	}
 
-	m_fileNameLabel->setText(Utils::elideText(QFileInfo(m_transfer->getTarget()).fileName(), m_fileNameLabel->fontMetrics(), nullptr, 300));
+	m_fileNameLabel->setText(Utils::elideText((m_transfer->getTarget().isEmpty() ? m_transfer->getSource().fileName() : QFileInfo(m_transfer->getTarget()).fileName()), m_fileNameLabel->fontMetrics(), nullptr, 300));
 	m_detailsLabel->setText(QLatin1String("<small>") + details + QLatin1String("</small>"));
 	m_iconLabel->setPixmap(QIcon::fromTheme(iconName, QFileIconProvider().icon(iconName)).pixmap(32, 32));
 	m_progressBar->setHasError(hasError);
-	m_progressBar->setRange(0, ((isIndeterminate && !hasError) ? 0 : 100));
-	m_progressBar->setValue(isIndeterminate ? (hasError ? 0 : -1) : ((m_transfer->getBytesTotal() > 0) ? qFloor(Utils::calculatePercent(m_transfer->getBytesReceived(), m_transfer->getBytesTotal())) : -1));
-	m_progressBar->setFormat(isIndeterminate ? tr("Unknown") : QLatin1String("%p%"));
+
+	if (m_transfer->getState() == Transfer::QueuedState)
+	{
+		m_progressBar->setRange(0, 100);
+		m_progressBar->setValue((m_transfer->getBytesTotal() > 0) ? qFloor(Utils::calculatePercent(m_transfer->getBytesReceived(), m_transfer->getBytesTotal())) : 0);
+		m_progressBar->setFormat(tr("Queued"));
+	}
+	else
+	{
+		m_progressBar->setRange(0, ((isIndeterminate && !hasError) ? 0 : 100));
+		m_progressBar->setValue(isIndeterminate ? (hasError ? 0 : -1) : ((m_transfer->getBytesTotal() > 0) ? qFloor(Utils::calculatePercent(m_transfer->getBytesReceived(), m_transfer->getBytesTotal())) : -1));
+		m_progressBar->setFormat(isIndeterminate ? tr("Unknown") : QLatin1String("%p%"));
+	}
 
 	switch (m_transfer->getState())
 	{
@@ -301,6 +319,11 @@ void TransferActionWidget::updateState()
 			m_toolButton->setIcon(ThemesManager::createIcon(QLatin1String("document-open-folder")));
 			m_toolButton->setToolTip(tr("Open Folder"));
 
+			break;
+		case Transfer::QueuedState:
+			m_toolButton->setIcon(ThemesManager::createIcon(QLatin1String("media-playback-start")));
+			m_toolButton->setToolTip(tr("Start Now"));
+
 			break;
 		default:
 			m_toolButton->setIcon(ThemesManager::createIcon(QLatin1String("task-reject")));
@@ -19,7 +19,6 @@
 
 #include "CacheContentsWidget.h"
 #include "../../../core/HistoryManager.h"
-#include "../../../core/NetworkCache.h"
 #include "../../../core/NetworkManagerFactory.h"
 #include "../../../core/ThemesManager.h"
 #include "../../../core/Utils.h"
@@ -28,6 +27,7 @@
 
 #include "ui_CacheContentsWidget.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QMimeDatabase>
 #include <QtCore/QTimer>
@@ -35,11 +35,14 @@
 #include <QtGui/QMouseEvent>
 #include <QtWidgets/QMenu>
 
+#define CACHE_ENTRIES_BATCH_SIZE 250
+
 namespace Otter
 {
 
 CacheContentsWidget::CacheContentsWidget(const QVariantMap &parameters, Window *window, QWidget *parent) : ContentsWidget(parameters, window, parent),
 	m_model(new QStandardItemModel(this)),
+	m_entriesWatcher(nullptr),
 	m_isLoading(true),
 	m_ui(new Ui::CacheContentsWidget)
 {
@@ -111,38 +114,116 @@ void CacheContentsWidget::triggerAction(int identifier, const QVariantMap &param
 
 void CacheContentsWidget::populateCache()
 {
+	if (m_entriesWatcher)
+	{
+		m_entriesWatcher->disconnect(this);
+		m_entriesWatcher->deleteLater();
+		m_entriesWatcher = nullptr;
+	}
+
+	m_pendingEntries.clear();
+	m_domainItems.clear();
+	m_entries.clear();
+
 	m_model->clear();
 	m_model->setHorizontalHeaderLabels({tr("Address"), tr("Type"), tr("Size"), tr("Last Modified"), tr("Expires")});
 	m_model->setHeaderData(0, Qt::Horizontal, 500, HeaderViewWidget::WidthRole);
 	m_model->setHeaderData(2, Qt::Horizontal, 150, HeaderViewWidget::WidthRole);
 	m_model->setSortRole(Qt::DisplayRole);
 
-	const NetworkCache *cache(NetworkManagerFactory::getCache());
-	const QVector<QUrl> entries(cache->getEntries());
-
-	for (int i = 0; i < entries.count(); ++i)
-	{
-		handleEntryAdded(entries.at(i));
-	}
-
-	m_model->sort(0);
+	NetworkCache *cache(NetworkManagerFactory::getCache());
 
-	if (m_isLoading)
+	if (m_ui->cacheViewWidget->model() != m_model)
 	{
 		m_ui->cacheViewWidget->setModel(m_model);
 		m_ui->cacheViewWidget->setLayoutDirection(Qt::LeftToRight);
 		m_ui->cacheViewWidget->setFilterRoles({Qt::DisplayRole, Qt::UserRole});
 
-		m_isLoading = false;
-
-		emit loadingStateChanged(WebWidget::FinishedLoadingState);
-
 		connect(cache, &NetworkCache::cleared, this, &CacheContentsWidget::populateCache);
 		connect(cache, &NetworkCache::entryAdded, this, &CacheContentsWidget::handleEntryAdded);
 		connect(cache, &NetworkCache::entryRemoved, this, &CacheContentsWidget::handleEntryRemoved);
 		connect(m_model, &QStandardItemModel::modelReset, this, &CacheContentsWidget::updateActions);
 		connect(m_ui->cacheViewWidget, &ItemViewWidget::needsActionsUpdate, this, &CacheContentsWidget::updateActions);
 	}
+
+	if (!m_isLoading)
+	{
+		m_isLoading = true;
+
+		emit loadingStateChanged(WebWidget::OngoingLoadingState);
+	}
+
+	m_ui->progressBar->setRange(0, 0);
+	m_ui->progressBar->show();
+
+	if (!cache->isIndexReady())
+	{
+		connect(cache, &NetworkCache::indexReady, this, &CacheContentsWidget::populateCache, Qt::UniqueConnection);
+
+		return;
+	}
+
+	m_pendingEntries = cache->getIndex();
+
+	m_ui->progressBar->setRange(0, m_pendingEntries.count());
+	m_ui->progressBar->setValue(0);
+
+	loadEntries();
+}
+
+void CacheContentsWidget::loadEntries()
+{
+	if (m_pendingEntries.isEmpty())
+	{
+		m_model->sort(0);
+
+		m_ui->progressBar->hide();
+
+		m_isLoading = false;
+
+		emit loadingStateChanged(WebWidget::FinishedLoadingState);
+
+		return;
+	}
+
+	const int amount(qMin(CACHE_ENTRIES_BATCH_SIZE, m_pendingEntries.count()));
+	const QVector<QPair<QUrl, NetworkCache::IndexEntry> > entries(m_pendingEntries.mid(m_pendingEntries.count() - amount));
+
+	m_pendingEntries.resize(m_pendingEntries.count() - amount);
+
+	m_entriesWatcher = new QFutureWatcher<QHash<QString, QVector<NetworkCache::EntryInformation> > >(this);
+	m_entriesWatcher->setFuture(QtConcurrent::run(&NetworkCache::readEntriesInformation, entries));
+
+	connect(m_entriesWatcher, &QFutureWatcher<QHash<QString, QVector<NetworkCache::EntryInformation> > >::finished, this, &CacheContentsWidget::handleEntriesLoaded);
+}
+
+void CacheContentsWidget::handleEntriesLoaded()
+{
+	if (!m_entriesWatcher)
+	{
+		return;
+	}
+
+	const QHash<QString, QVector<NetworkCache::EntryInformation> > entries(m_entriesWatcher->result());
+	QHash<QString, QVector<NetworkCache::EntryInformation> >::const_iterator iterator;
+	int amount(0);
+
+	m_entriesWatcher->deleteLater();
+	m_entriesWatcher = nullptr;
+
+	for (iterator = entries.constBegin(); iterator != entries.constEnd(); ++iterator)
+	{
+		for (int i = 0; i < iterator.value().count(); ++i)
+		{
+			addEntry(iterator.value().at(i), false);
+		}
+
+		amount += iterator.value().count();
+	}
+
+	m_ui->progressBar->setValue(m_ui->progressBar->value() + amount);
+
+	loadEntries();
 }
 
 void CacheContentsWidget::removeEntry()
@@ -222,31 +303,9 @@ void CacheContentsWidget::copyEntryLink()
 
 void CacheContentsWidget::handleEntryAdded(const QUrl &entry)
 {
-	const QString domain(entry.host());
-	QStandardItem *domainItem(findDomainItem(domain));
-
-	if (domainItem)
-	{
-		for (int i = 0; i < domainItem->rowCount(); ++i)
-		{
-			if (ItemModel::getItemData(domainItem->child(i, 0), Qt::UserRole).toUrl() == entry)
-			{
-				return;
-			}
-		}
-	}
-	else
+	if (m_entries.contains(entry))
 	{
-		domainItem = new QStandardItem(HistoryManager::getIcon(QUrl(QStringLiteral("http://%1/").arg(domain))), domain);
-		domainItem->setToolTip(domain);
-
-		m_model->appendRow(domainItem);
-		m_model->setItem(domainItem->row(), 2, new QStandardItem());
-
-		if (sender())
-		{
-			m_model->sort(0);
-		}
+		return;
 	}
 
 	NetworkCache *cache(NetworkManagerFactory::getCache());
@@ -265,33 +324,73 @@ void CacheContentsWidget::handleEntryAdded(const QUrl &entry)
 		}
 	}
 
-	const QMimeType mimeType((device && type.isEmpty()) ? QMimeDatabase().mimeTypeForData(device) : QMimeDatabase().mimeTypeForName(type));
-	QList<QStandardItem*> entryItems({new QStandardItem(entry.path()), new QStandardItem(mimeType.name()), new QStandardItem(device ? Utils::formatUnit(device->size()) : QString()), new QStandardItem(Utils::formatDateTime(metaData.lastModified())), new QStandardItem(Utils::formatDateTime(metaData.expirationDate()))});
-	entryItems[0]->setData(entry, Qt::UserRole);
+	NetworkCache::EntryInformation information;
+	information.url = entry;
+	information.mimeType = ((device && type.isEmpty()) ? QMimeDatabase().mimeTypeForData(device) : QMimeDatabase().mimeTypeForName(type)).name();
+	information.lastModified = metaData.lastModified();
+	information.expirationDate = metaData.expirationDate();
+	information.size = (device ? device->size() : 0);
+
+	if (device)
+	{
+		device->deleteLater();
+	}
+
+	addEntry(information, true);
+}
+
+void CacheContentsWidget::addEntry(const NetworkCache::EntryInformation &entry, bool isLiveUpdate)
+{
+	if (m_entries.contains(entry.url))
+	{
+		return;
+	}
+
+	const QString domain(entry.url.host());
+	QStandardItem *domainItem(findDomainItem(domain));
+
+	if (!domainItem)
+	{
+		domainItem = new QStandardItem(HistoryManager::getIcon(QUrl(QStringLiteral("http://%1/").arg(domain))), domain);
+		domainItem->setToolTip(domain);
+
+		m_model->appendRow(domainItem);
+		m_model->setItem(domainItem->row(), 2, new QStandardItem());
+
+		m_domainItems[domain] = domainItem;
+
+		if (isLiveUpdate)
+		{
+			m_model->sort(0);
+		}
+	}
+
+	QList<QStandardItem*> entryItems({new QStandardItem(entry.url.path()), new QStandardItem(entry.mimeType), new QStandardItem((entry.size > 0) ? Utils::formatUnit(entry.size) : QString()), new QStandardItem(Utils::formatDateTime(entry.lastModified)), new QStandardItem(Utils::formatDateTime(entry.expirationDate))});
+	entryItems[0]->setData(entry.url, Qt::UserRole);
 	entryItems[0]->setFlags(entryItems[0]->flags() | Qt::ItemNeverHasChildren);
 	entryItems[1]->setFlags(entryItems[1]->flags() | Qt::ItemNeverHasChildren);
-	entryItems[2]->setData((device ? device->size() : 0), Qt::UserRole);
+	entryItems[2]->setData(entry.size, Qt::UserRole);
 	entryItems[2]->setFlags(entryItems[2]->flags() | Qt::ItemNeverHasChildren);
 	entryItems[3]->setFlags(entryItems[3]->flags() | Qt::ItemNeverHasChildren);
 	entryItems[4]->setFlags(entryItems[4]->flags() | Qt::ItemNeverHasChildren);
 
-	if (device)
+	if (entry.size > 0)
 	{
 		QStandardItem *sizeItem(m_model->item(domainItem->row(), 2));
 
 		if (sizeItem)
 		{
-			sizeItem->setData((sizeItem->data(Qt::UserRole).toLongLong() + device->size()), Qt::UserRole);
+			sizeItem->setData((sizeItem->data(Qt::UserRole).toLongLong() + entry.size), Qt::UserRole);
 			sizeItem->setText(Utils::formatUnit(sizeItem->data(Qt::UserRole).toLongLong()));
 		}
-
-		device->deleteLater();
 	}
 
 	domainItem->appendRow(entryItems);
 	domainItem->setText(QStringLiteral("%1 (%2)").arg(domain).arg(domainItem->rowCount()));
 
-	if (sender())
+	m_entries.insert(entry.url);
+
+	if (isLiveUpdate)
 	{
 		domainItem->sortChildren(0, Qt::DescendingOrder);
 	}
@@ -316,8 +415,12 @@ void CacheContentsWidget::handleEntryRemoved(const QUrl &entry)
 
 			m_model->removeRow(entryItem->row(), domainItem->index());
 
+			m_entries.remove(entry);
+
 			if (domainItem->rowCount() == 0)
 			{
+				m_domainItems.remove(domainItem->toolTip());
+
 				m_model->invisibleRootItem()->removeRow(domainItem->row());
 			}
 			else
@@ -512,17 +615,7 @@ void CacheContentsWidget::updateActions()
 
 QStandardItem* CacheContentsWidget::findDomainItem(const QString &domain)
 {
-	for (int i = 0; i < m_model->rowCount(); ++i)
-	{
-		QStandardItem *domainItem(m_model->item(i, 0));
-
-		if (domainItem && domain == domainItem->toolTip())
-		{
-			return domainItem;
-		}
-	}
-
-	return nullptr;
+	return m_domainItems.value(domain);
 }
 
 QString CacheContentsWidget::getTitle() const
@@ -20,6 +20,7 @@
 #ifndef OTTER_CacheContentsWidget_H
 #define OTTER_CacheContentsWidget_H
 
+#include "../../../core/NetworkCache.h"
 #include "../../../ui/ContentsWidget.h"
 
 #include <QtGui/QStandardItemModel>
@@ -56,6 +57,8 @@ public slots:
 
 protected:
 	void changeEvent(QEvent *event) override;
+	void loadEntries();
+	void addEntry(const NetworkCache::EntryInformation &entry, bool isLiveUpdate);
 	QStandardItem* findDomainItem(const QString &domain);
 	QUrl getEntry(const QModelIndex &index) const;
 
@@ -66,6 +69,7 @@ protected slots:
 	void removeDomainEntriesOrEntry();
 	void openEntry();
 	void copyEntryLink();
+	void handleEntriesLoaded();
 	void handleEntryAdded(const QUrl &entry);
 	void handleEntryRemoved(const QUrl &entry);
 	void showContextMenu(const QPoint &position);
@@ -73,6 +77,10 @@ protected slots:
 
 private:
 	QStandardItemModel *m_model;
+	QFutureWatcher<QHash<QString, QVector<NetworkCache::EntryInformation> > > *m_entriesWatcher;
+	QVector<QPair<QUrl, NetworkCache::IndexEntry> > m_pendingEntries;
+	QHash<QString, QStandardItem*> m_domainItems;
+	QSet<QUrl> m_entries;
 	bool m_isLoading;
 	Ui::CacheContentsWidget *m_ui;
 };
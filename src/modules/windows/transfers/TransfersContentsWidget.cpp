@@ -189,13 +189,13 @@ void TransfersContentsWidget::stopResumeTransfer()
 
 	if (transfer)
 	{
-		if (transfer->getState() == Transfer::RunningState)
+		if (transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::QueuedState)
 		{
 			transfer->stop();
 		}
 		else if (transfer->getState() == Transfer::ErrorState)
 		{
-			transfer->resume();
+			TransfersManager::resumeTransfer(transfer);
 		}
 
 		updateActions();
@@ -206,9 +206,18 @@ void TransfersContentsWidget::redownloadTransfer()
 {
 	Transfer *transfer(getTransfer(m_ui->transfersViewWidget->getCurrentIndex()));
 
-	if (transfer)
+	if (!transfer)
+	{
+		return;
+	}
+
+	if (transfer->getState() == Transfer::QueuedState)
 	{
-		transfer->restart();
+		TransfersManager::startQueuedTransfer(transfer);
+	}
+	else
+	{
+		TransfersManager::restartTransfer(transfer);
 	}
 }
 
@@ -261,6 +270,10 @@ void TransfersContentsWidget::handleTransferChanged(Transfer *transfer)
 
 	switch (transfer->getState())
 	{
+		case Transfer::QueuedState:
+			iconName = QLatin1String("media-playback-pause");
+
+			break;
 		case Transfer::RunningState:
 			iconName = QLatin1String("task-ongoing");
 
@@ -289,7 +302,7 @@ void TransfersContentsWidget::handleTransferChanged(Transfer *transfer)
 
 				break;
 			case 1:
-				m_model->setData(index, QFileInfo(transfer->getTarget()).fileName(), Qt::DisplayRole);
+				m_model->setData(index, (transfer->getTarget().isEmpty() ? transfer->getSource().fileName() : QFileInfo(transfer->getTarget()).fileName()), Qt::DisplayRole);
 
 				break;
 			case 2:
@@ -305,7 +318,14 @@ void TransfersContentsWidget::handleTransferChanged(Transfer *transfer)
 
 				break;
 			case 4:
-				m_model->setData(index, ((isIndeterminate || transfer->getRemainingTime() <= 0) ? QString() : Utils::formatElapsedTime(transfer->getRemainingTime())), Qt::DisplayRole);
+				if (transfer->getState() == Transfer::QueuedState)
+				{
+					m_model->setData(index, tr("Queued (%1)").arg(TransfersManager::getQueuePosition(transfer)), Qt::DisplayRole);
+				}
+				else
+				{
+					m_model->setData(index, ((isIndeterminate || transfer->getRemainingTime() <= 0) ? QString() : Utils::formatElapsedTime(transfer->getRemainingTime())), Qt::DisplayRole);
+				}
 
 				break;
 			case 5:
@@ -381,8 +401,8 @@ void TransfersContentsWidget::showContextMenu(const QPoint &position)
 		menu.addMenu(openWithMenu);
 		menu.addAction(tr("Open Folder"), this, &TransfersContentsWidget::openTransferFolder)->setEnabled(canOpen || QFileInfo(transfer->getTarget()).dir().exists());
 		menu.addSeparator();
-		menu.addAction(((transfer->getState() == Transfer::ErrorState) ? tr("Resume") : tr("Stop")), this, &TransfersContentsWidget::stopResumeTransfer)->setEnabled(transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState);
-		menu.addAction(tr("Redownload"), this, &TransfersContentsWidget::redownloadTransfer);
+		menu.addAction(((transfer->getState() == Transfer::ErrorState) ? tr("Resume") : tr("Stop")), this, &TransfersContentsWidget::stopResumeTransfer)->setEnabled(transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState || transfer->getState() == Transfer::QueuedState);
+		menu.addAction(((transfer->getState() == Transfer::QueuedState) ? tr("Start Now") : tr("Redownload")), this, &TransfersContentsWidget::redownloadTransfer);
 		menu.addSeparator();
 		menu.addAction(tr("Copy Transfer Information"), this, &TransfersContentsWidget::copyTransferInformation);
 		menu.addSeparator();
@@ -420,7 +440,7 @@ void TransfersContentsWidget::updateActions()
 		m_ui->stopResumeButton->setIcon(ThemesManager::createIcon(QLatin1String("task-reject")));
 	}
 
-	m_ui->stopResumeButton->setEnabled(transfer && (transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState));
+	m_ui->stopResumeButton->setEnabled(transfer && (transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState || transfer->getState() == Transfer::QueuedState));
 	m_ui->redownloadButton->setEnabled(transfer);
 
 	if (transfer)
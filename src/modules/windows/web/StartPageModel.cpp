@@ -24,18 +24,47 @@
 #include "../../../core/SettingsManager.h"
 #include "../../../core/WebBackend.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QMimeData>
 #include <QtCore/QTimer>
 #include <QtGui/QPainter>
 
+#define STARTPAGE_THUMBNAIL_JOB_TIMEOUT 30000
+#define STARTPAGE_THUMBNAIL_JOBS_LIMIT 4
+#define STARTPAGE_THUMBNAILS_CACHE_LIMIT 32768
+
 namespace Otter
 {
 
 StartPageModel::StartPageModel(QObject *parent) : QStandardItemModel(parent),
-	m_bookmark(nullptr)
+	m_bookmark(nullptr),
+	m_isMigratingThumbnails(false)
 {
+	m_thumbnailsCache.setMaxCost(STARTPAGE_THUMBNAILS_CACHE_LIMIT);
+
+	const QString thumbnailsPath(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")));
+
+	if (!SessionsManager::isReadOnly() && !QDir(thumbnailsPath).entryList({QLatin1String("*.png")}, QDir::Files).isEmpty())
+	{
+		QFutureWatcher<void> *watcher(new QFutureWatcher<void>(this));
+
+		m_isMigratingThumbnails = true;
+
+		connect(watcher, &QFutureWatcher<void>::finished, this, [=]()
+		{
+			m_isMigratingThumbnails = false;
+
+			watcher->deleteLater();
+
+			reloadModel();
+		});
+
+		watcher->setFuture(QtConcurrent::run(&StartPageModel::migrateThumbnails, thumbnailsPath));
+	}
+
 	handleOptionChanged(SettingsManager::Backends_WebOption);
 	reloadModel();
 
@@ -81,7 +110,7 @@ void StartPageModel::reloadModel()
 					item->setData(true, IsEmptyRole);
 				}
 
-				if (url.isValid() && !QFile::exists(getThumbnailPath(identifier)))
+				if (url.isValid() && !QFile::exists(getThumbnailPath(identifier)) && !(m_isMigratingThumbnails && QFile::exists(getLegacyThumbnailPath(identifier))))
 				{
 					requestThumbnail(url, identifier);
 				}
@@ -162,12 +191,7 @@ void StartPageModel::handleBookmarkMoved(BookmarksModel::Bookmark *bookmark, Boo
 	{
 		if (bookmark->parent() != m_bookmark)
 		{
-			const QString path(getThumbnailPath(bookmark->getIdentifier()));
-
-			if (QFile::exists(path))
-			{
-				QFile::remove(path);
-			}
+			removeThumbnail(bookmark->getIdentifier());
 		}
 
 		if (bookmark == m_bookmark || previousParent == m_bookmark || m_bookmark->isAncestorOf(bookmark) || m_bookmark->isAncestorOf(previousParent))
@@ -181,12 +205,7 @@ void StartPageModel::handleBookmarkRemoved(BookmarksModel::Bookmark *bookmark, B
 {
 	if (m_bookmark && (bookmark == m_bookmark || previousParent == m_bookmark || m_bookmark->isAncestorOf(previousParent)))
 	{
-		const QString path(getThumbnailPath(bookmark->getIdentifier()));
-
-		if (QFile::exists(path))
-		{
-			QFile::remove(path);
-		}
+		removeThumbnail(bookmark->getIdentifier());
 
 		QTimer::singleShot(100, this, &StartPageModel::reloadModel);
 	}
@@ -199,26 +218,113 @@ void StartPageModel::handleThumbnailCreated(quint64 identifier, const QPixmap &t
 		return;
 	}
 
-	const bool needsTitleUpdate(m_reloads[identifier]);
 	BookmarksModel::Bookmark *bookmark(BookmarksManager::getModel()->getBookmark(identifier));
 
-	m_reloads.remove(identifier);
+	if (bookmark && m_reloads[identifier])
+	{
+		bookmark->setData(title, BookmarksModel::TitleRole);
+	}
+
+	if (SessionsManager::isReadOnly() || thumbnail.isNull() || !bookmark)
+	{
+		ThumbnailInformation information;
+		information.identifier = identifier;
+
+		handleThumbnailSaved(information);
+
+		return;
+	}
+
+	QDir().mkpath(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")));
 
-	if (!SessionsManager::isReadOnly() && !thumbnail.isNull() && bookmark)
+	QFutureWatcher<ThumbnailInformation> *watcher(new QFutureWatcher<ThumbnailInformation>(this));
+
+	connect(watcher, &QFutureWatcher<ThumbnailInformation>::finished, this, [=]()
 	{
-		QDir().mkpath(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")));
+		handleThumbnailSaved(watcher->result());
+
+		watcher->deleteLater();
+	});
+
+	watcher->setFuture(QtConcurrent::run(&StartPageModel::saveThumbnail, thumbnail.toImage(), identifier, getThumbnailPath(identifier), getThumbnailPath(identifier, true)));
+}
 
-		thumbnail.save(getThumbnailPath(identifier), "png");
+void StartPageModel::handleThumbnailSaved(const ThumbnailInformation &information)
+{
+	m_reloads.remove(information.identifier);
+
+	if (!information.thumbnail.isNull())
+	{
+		cacheThumbnail(getThumbnailPath(information.identifier), QPixmap::fromImage(information.thumbnail));
+		cacheThumbnail(getThumbnailPath(information.identifier, true), QPixmap::fromImage(information.smallThumbnail));
 	}
 
+	const BookmarksModel::Bookmark *bookmark(BookmarksManager::getModel()->getBookmark(information.identifier));
+
 	if (bookmark)
 	{
-		if (needsTitleUpdate)
+		emit isReloadingTileChanged(index(bookmark->index().row(), bookmark->index().column()));
+	}
+}
+
+void StartPageModel::processThumbnailsQueue()
+{
+	while (m_runningThumbnailJobs.count() < STARTPAGE_THUMBNAIL_JOBS_LIMIT && !m_thumbnailJobsQueue.isEmpty())
+	{
+		const ThumbnailJob thumbnailJob(m_thumbnailJobsQueue.takeFirst());
+		WebPageThumbnailJob *job(thumbnailJob.job);
+
+		if (!job)
 		{
-			bookmark->setData(title, BookmarksModel::TitleRole);
+			m_reloads.remove(thumbnailJob.identifier);
+
+			continue;
 		}
 
-		emit isReloadingTileChanged(index(bookmark->index().row(), bookmark->index().column()));
+		m_runningThumbnailJobs.insert(job);
+
+		connect(job, &WebPageThumbnailJob::destroyed, this, [=]()
+		{
+			if (m_runningThumbnailJobs.remove(job))
+			{
+				ThumbnailInformation information;
+				information.identifier = thumbnailJob.identifier;
+
+				handleThumbnailSaved(information);
+				processThumbnailsQueue();
+			}
+		});
+
+		QTimer::singleShot(STARTPAGE_THUMBNAIL_JOB_TIMEOUT, job, [=]()
+		{
+			if (m_runningThumbnailJobs.contains(job))
+			{
+				job->cancel();
+				job->deleteLater();
+			}
+		});
+
+		job->start();
+	}
+}
+
+void StartPageModel::cacheThumbnail(const QString &path, const QPixmap &thumbnail)
+{
+	m_thumbnailsCache.insert(path, new QPixmap(thumbnail), qMax(1, ((thumbnail.width() * thumbnail.height() * 4) / 1024)));
+}
+
+void StartPageModel::removeThumbnail(quint64 identifier)
+{
+	const QStringList paths({getThumbnailPath(identifier), getThumbnailPath(identifier, true), getLegacyThumbnailPath(identifier)});
+
+	for (int i = 0; i < paths.count(); ++i)
+	{
+		m_thumbnailsCache.remove(paths.at(i));
+
+		if (QFile::exists(paths.at(i)))
+		{
+			QFile::remove(paths.at(i));
+		}
 	}
 }
 
@@ -262,11 +368,76 @@ BookmarksModel::Bookmark* StartPageModel::getBookmark(const QModelIndex &index)
 	return (data.isValid() ? BookmarksManager::getModel()->getBookmark(data.toULongLong()) : nullptr);
 }
 
-QString StartPageModel::getThumbnailPath(quint64 identifier)
+void StartPageModel::migrateThumbnails(const QString &directory)
+{
+	const QFileInfoList entries(QDir(directory).entryInfoList({QLatin1String("*.png")}, QDir::Files));
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		bool isValid(false);
+		const quint64 identifier(entries.at(i).completeBaseName().toULongLong(&isValid));
+
+		if (isValid && !QFile::exists(getThumbnailPath(identifier)))
+		{
+			const QImage thumbnail(entries.at(i).absoluteFilePath());
+
+			if (!thumbnail.isNull())
+			{
+				saveThumbnail(thumbnail, identifier, getThumbnailPath(identifier), getThumbnailPath(identifier, true));
+			}
+		}
+
+		QFile::remove(entries.at(i).absoluteFilePath());
+	}
+}
+
+StartPageModel::ThumbnailInformation StartPageModel::saveThumbnail(const QImage &thumbnail, quint64 identifier, const QString &path, const QString &smallPath)
+{
+	ThumbnailInformation information;
+	information.identifier = identifier;
+	information.thumbnail = thumbnail.convertToFormat(QImage::Format_RGB32);
+	information.smallThumbnail = information.thumbnail.scaled((information.thumbnail.size() / 2), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+	information.thumbnail.save(path, "jpg", 85);
+	information.smallThumbnail.save(smallPath, "jpg", 85);
+
+	return information;
+}
+
+QString StartPageModel::getThumbnailPath(quint64 identifier, bool isSmall)
+{
+	return SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(identifier) + (isSmall ? QLatin1String("-small.jpg") : QLatin1String(".jpg"));
+}
+
+QString StartPageModel::getLegacyThumbnailPath(quint64 identifier)
 {
 	return SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(identifier) + QLatin1String(".png");
 }
 
+QPixmap StartPageModel::getThumbnail(quint64 identifier, const QSize &size)
+{
+	const QSize tileSize(SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt());
+	const bool isSmall(size.isValid() && size.width() <= (tileSize.width() / 2) && size.height() <= (tileSize.height() / 2));
+	const QString path(getThumbnailPath(identifier, isSmall));
+	const QPixmap *cachedThumbnail(m_thumbnailsCache.object(path));
+
+	if (cachedThumbnail)
+	{
+		return *cachedThumbnail;
+	}
+
+	const QPixmap thumbnail(path);
+
+	if (thumbnail.isNull())
+	{
+		return (isSmall ? getThumbnail(identifier) : QPixmap());
+	}
+
+	cacheThumbnail(path, thumbnail);
+
+	return thumbnail;
+}
+
 QVariant StartPageModel::data(const QModelIndex &index, int role) const
 {
 	if (role == IsReloadingRole)
@@ -324,18 +495,37 @@ bool StartPageModel::requestThumbnail(const QUrl &url, quint64 identifier, bool
 		return false;
 	}
 
+	if (m_reloads.contains(identifier))
+	{
+		m_reloads[identifier] = (m_reloads[identifier] || needsTitleUpdate);
+
+		return true;
+	}
+
 	WebPageThumbnailJob *job(AddonsManager::getWebBackend()->createPageThumbnailJob(url, {SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt()}));
 
 	if (job)
 	{
 		connect(job, &WebPageThumbnailJob::jobFinished, this, [=]()
 		{
+			if (!m_runningThumbnailJobs.remove(job))
+			{
+				return;
+			}
+
 			handleThumbnailCreated(identifier, job->getThumbnail(), job->getTitle());
+			processThumbnailsQueue();
 		});
 
+		ThumbnailJob thumbnailJob;
+		thumbnailJob.job = job;
+		thumbnailJob.identifier = identifier;
+
 		m_reloads[identifier] = needsTitleUpdate;
 
-		job->start();
+		m_thumbnailJobsQueue.append(thumbnailJob);
+
+		processThumbnailsQueue();
 
 		return true;
 	}
@@ -22,9 +22,16 @@
 
 #include "../../../core/BookmarksModel.h"
 
+#include <QtCore/QCache>
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
+#include <QtGui/QImage>
+
 namespace Otter
 {
 
+class WebPageThumbnailJob;
+
 class StartPageModel final : public QStandardItemModel
 {
 	Q_OBJECT
@@ -41,7 +48,8 @@ public:
 
 	QMimeData* mimeData(const QModelIndexList &indexes) const override;
 	static BookmarksModel::Bookmark* getBookmark(const QModelIndex &index);
-	static QString getThumbnailPath(quint64 identifier);
+	static QString getThumbnailPath(quint64 identifier, bool isSmall = false);
+	QPixmap getThumbnail(quint64 identifier, const QSize &size = {});
 	QVariant data(const QModelIndex &index, int role) const override;
 	QStringList mimeTypes() const override;
 	bool reloadTile(const QModelIndex &index, bool needsTitleUpdate = false);
@@ -50,9 +58,28 @@ public:
 
 public slots:
 	void reloadModel();
+	void removeThumbnail(quint64 identifier);
 	QModelIndex addTile(const QUrl &url);
 
 protected:
+	struct ThumbnailInformation final
+	{
+		QImage thumbnail;
+		QImage smallThumbnail;
+		quint64 identifier = 0;
+	};
+
+	struct ThumbnailJob final
+	{
+		QPointer<WebPageThumbnailJob> job;
+		quint64 identifier = 0;
+	};
+
+	void processThumbnailsQueue();
+	void cacheThumbnail(const QString &path, const QPixmap &thumbnail);
+	static void migrateThumbnails(const QString &directory);
+	static ThumbnailInformation saveThumbnail(const QImage &thumbnail, quint64 identifier, const QString &path, const QString &smallPath);
+	static QString getLegacyThumbnailPath(quint64 identifier);
 	bool requestThumbnail(const QUrl &url, quint64 identifier, bool needsTitleUpdate = false);
 
 protected slots:
@@ -62,10 +89,15 @@ protected slots:
 	void handleBookmarkMoved(BookmarksModel::Bookmark *bookmark, BookmarksModel::Bookmark *previousParent);
 	void handleBookmarkRemoved(BookmarksModel::Bookmark *bookmark, BookmarksModel::Bookmark *previousParent);
 	void handleThumbnailCreated(quint64 identifier, const QPixmap &thumbnail, const QString &title);
+	void handleThumbnailSaved(const ThumbnailInformation &information);
 
 private:
 	BookmarksModel::Bookmark *m_bookmark;
+	QVector<ThumbnailJob> m_thumbnailJobsQueue;
+	QSet<WebPageThumbnailJob*> m_runningThumbnailJobs;
+	QCache<QString, QPixmap> m_thumbnailsCache;
 	QHash<quint64, bool> m_reloads;
+	bool m_isMigratingThumbnails;
 
 signals:
 	void modelModified();
@@ -24,6 +24,7 @@
 #include "../../../core/BookmarksModel.h"
 #include "../../../core/GesturesManager.h"
 #include "../../../core/HistoryManager.h"
+#include "../../../core/NetworkManagerFactory.h"
 #include "../../../core/SessionsManager.h"
 #include "../../../core/SettingsManager.h"
 #include "../../../core/ThemesManager.h"
@@ -181,7 +182,7 @@ void TileDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
 				pixmapPainter.setBrush(Qt::white);
 				pixmapPainter.setPen(Qt::transparent);
 				pixmapPainter.drawRect(rectangle);
-				pixmapPainter.drawPixmap(rectangle, QPixmap(StartPageModel::getThumbnailPath(identifier)), rectangle.translated(-rectangle.topLeft()));
+				pixmapPainter.drawPixmap(rectangle, StartPageWidget::getModel()->getThumbnail(identifier, rectangle.size()), rectangle.translated(-rectangle.topLeft()));
 				pixmapPainter.restore();
 
 				break;
@@ -850,12 +851,7 @@ void StartPageWidget::removeTile()
 
 	if (bookmark)
 	{
-		const QString path(StartPageModel::getThumbnailPath(bookmark->getIdentifier()));
-
-		if (QFile::exists(path))
-		{
-			QFile::remove(path);
-		}
+		m_model->removeThumbnail(bookmark->getIdentifier());
 
 		bookmark->remove();
 	}
@@ -1077,6 +1073,11 @@ void StartPageWidget::showContextMenu(const QPoint &position)
 	menu.exec(hitPosition);
 }
 
+StartPageModel* StartPageWidget::getModel()
+{
+	return m_model;
+}
+
 Animation* StartPageWidget::getLoadingAnimation()
 {
 	return m_spinnerAnimation;
@@ -1322,6 +1323,11 @@ bool StartPageWidget::eventFilter(QObject *object, QEvent *event)
 					const QKeySequence shortcut(ActionsManager::getActionShortcut(ActionsManager::OpenBookmarkAction, {{QLatin1String("startPageTile"), (index.row() + 1)}}));
 
 					toolTip = Utils::appendShortcut(bookmark->getTitle(), shortcut);
+
+					if (!m_window->isPrivate())
+					{
+						NetworkManagerFactory::preconnect(bookmark->getUrl());
+					}
 				}
 			}
 		}
@@ -194,6 +194,10 @@ MainWindow::MainWindow(const QVariantMap &parameters, const Session::MainWindow
 	connect(ToolBarsManager::getInstance(), &ToolBarsManager::toolBarRemoved, this, &MainWindow::handleToolBarRemoved);
 	connect(TransfersManager::getInstance(), &TransfersManager::transferStarted, this, &MainWindow::handleTransferStarted);
 	connect(m_workspace, &WorkspaceWidget::arbitraryActionsStateChanged, this, &MainWindow::arbitraryActionsStateChanged);
+	connect(m_tabBar, &TabBarWidget::tabMoved, this, [&](int from, int to)
+	{
+		SessionsManager::journalWindowMoved(this, from, to);
+	});
 
 	if (session.geometry.isEmpty())
 	{
@@ -611,36 +615,35 @@ void MainWindow::triggerAction(int identifier, const QVariantMap &parameters, Ac
 				{
 					if (parameters.value(QLatin1String("needsInterpretation"), false).toBool())
 					{
-						const InputInterpreter::InterpreterResult result(InputInterpreter::interpret(parameters[QLatin1String("url")].toString(), InputInterpreter::NoBookmarkKeywordsFlag));
-
-						if (!result.isValid())
+						InputInterpreter::interpret(parameters[QLatin1String("url")].toString(), InputInterpreter::NoBookmarkKeywordsFlag, this, [=](const InputInterpreter::InterpreterResult &result)
 						{
-							return;
-						}
+							QVariantMap mutableParameters(parameters);
+							mutableParameters.remove(QLatin1String("needsInterpretation"));
 
-						switch (result.type)
-						{
-							case InputInterpreter::InterpreterResult::BookmarkType:
-								{
-									QVariantMap mutableParameters(parameters);
-									mutableParameters.remove(QLatin1String("needsInterpretation"));
+							switch (result.type)
+							{
+								case InputInterpreter::InterpreterResult::BookmarkType:
 									mutableParameters[QLatin1String("bookmark")] = result.bookmark->getIdentifier();
 
 									triggerAction(ActionsManager::OpenBookmarkAction, mutableParameters, trigger);
-								}
 
-								return;
-							case InputInterpreter::InterpreterResult::UrlType:
-								url = result.url;
+									break;
+								case InputInterpreter::InterpreterResult::UrlType:
+									mutableParameters[QLatin1String("url")] = result.url;
 
-								break;
-							case InputInterpreter::InterpreterResult::SearchType:
-								search(result.searchQuery, result.searchEngine, SessionsManager::calculateOpenHints(parameters, (trigger == ActionsManager::KeyboardTrigger || trigger == ActionsManager::MouseTrigger)));
+									triggerAction(ActionsManager::OpenUrlAction, mutableParameters, trigger);
 
-								return;
-							default:
-								return;
-						}
+									break;
+								case InputInterpreter::InterpreterResult::SearchType:
+									search(result.searchQuery, result.searchEngine, SessionsManager::calculateOpenHints(parameters, (trigger == ActionsManager::KeyboardTrigger || trigger == ActionsManager::MouseTrigger)));
+
+									break;
+								default:
+									break;
+							}
+						});
+
+						return;
 					}
 					else
 					{
@@ -1233,6 +1236,7 @@ void MainWindow::search(const QString &query, const QString &searchEngine, Sessi
 
 void MainWindow::restoreSession(const Session::MainWindow &session)
 {
+	QVector<Window*> restoredWindows;
 	int index(session.index);
 
 	if (index >= session.windows.count())
@@ -1255,6 +1259,10 @@ void MainWindow::restoreSession(const Session::MainWindow &session)
 	}
 	else
 	{
+		const bool deferLoading(SettingsManager::getOption(SettingsManager::Sessions_DeferTabsLoadingOption).toBool());
+
+		restoredWindows.reserve(session.windows.count());
+
 		for (int i = 0; i < session.windows.count(); ++i)
 		{
 			QVariantMap parameters({{QLatin1String("size"), ((session.windows.at(i).state.state == Qt::WindowMaximized || !session.windows.at(i).state.geometry.isValid()) ? m_workspace->size() : session.windows.at(i).state.geometry.size())}});
@@ -1265,7 +1273,12 @@ void MainWindow::restoreSession(const Session::MainWindow &session)
 			}
 
 			Window *window(new Window(parameters, nullptr, this));
-			window->setSession(session.windows.at(i), SettingsManager::getOption(SettingsManager::Sessions_DeferTabsLoadingOption).toBool());
+			window->setSession(session.windows.at(i), true);
+
+			if (!deferLoading)
+			{
+				restoredWindows.append(window);
+			}
 
 			if (index < 0 && session.windows.at(i).state.state != Qt::WindowMinimized)
 			{
@@ -1284,6 +1297,11 @@ void MainWindow::restoreSession(const Session::MainWindow &session)
 
 	m_workspace->markAsRestored();
 
+	if (!restoredWindows.isEmpty())
+	{
+		SessionsManager::queueWindowsRestoration(restoredWindows);
+	}
+
 	emit sessionRestored();
 }
 
@@ -1436,6 +1454,8 @@ void MainWindow::addWindow(Window *window, SessionsManager::OpenHints hints, int
 	connect(window, &Window::isPinnedChanged, this, &MainWindow::handleWindowIsPinnedChanged);
 	connect(window, &Window::requestedNewWindow, this, &MainWindow::openWindow);
 
+	SessionsManager::journalWindowOpened(window);
+
 	emit windowAdded(window->getIdentifier());
 }
 
@@ -1465,6 +1485,8 @@ void MainWindow::moveWindow(Window *window, MainWindow *mainWindow, const QVaria
 		newWindow->setPinned(true);
 	}
 
+	SessionsManager::journalWindowClosed(window);
+
 	m_tabBar->removeTab(getWindowIndex(window->getIdentifier()));
 
 	m_windows.remove(window->getIdentifier());
@@ -1700,6 +1722,8 @@ void MainWindow::handleRequestedCloseWindow(Window *window)
 		}
 	}
 
+	SessionsManager::journalWindowClosed(window);
+
 	m_tabBar->removeTab(index);
 
 	if (m_tabSwitchingOrderIndex >= 0)
@@ -2442,7 +2466,7 @@ ActionsManager::ActionDefinition::State MainWindow::getActionState(int identifie
 	return state;
 }
 
-Session::MainWindow MainWindow::getSession() const
+Session::MainWindow MainWindow::getSession(bool includeWindows) const
 {
 	const QVector<Qt::ToolBarArea> areas({Qt::LeftToolBarArea, Qt::RightToolBarArea, Qt::TopToolBarArea, Qt::BottomToolBarArea});
 	Session::MainWindow session;
@@ -2476,7 +2500,10 @@ Session::MainWindow MainWindow::getSession() const
 
 		if (window && !window->isPrivate())
 		{
-			session.windows.append(window->getSession());
+			if (includeWindows)
+			{
+				session.windows.append(window->getSession());
+			}
 		}
 		else if (i < session.index)
 		{
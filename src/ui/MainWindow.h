@@ -72,7 +72,7 @@ public:
 	QString getTitle() const;
 	QUrl getUrl() const;
 	ActionsManager::ActionDefinition::State getActionState(int identifier, const QVariantMap &parameters = {}) const override;
-	Session::MainWindow getSession() const;
+	Session::MainWindow getSession(bool includeWindows = true) const;
 	Session::MainWindow::ToolBarState getToolBarState(int identifier) const;
 	QVector<ToolBarWidget*> getToolBars(Qt::ToolBarArea area) const;
 	QVector<Session::ClosedWindow> getClosedWindows() const;
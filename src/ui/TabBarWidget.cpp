@@ -72,6 +72,7 @@ TabHandleWidget::TabHandleWidget(Window *window, TabBarWidget *parent) : QWidget
 	connect(window, &Window::needsAttention, this, &TabHandleWidget::markAsNeedingAttention);
 	connect(window, &Window::titleChanged, this, &TabHandleWidget::updateTitle);
 	connect(window, &Window::iconChanged, this, static_cast<void(TabHandleWidget::*)()>(&TabHandleWidget::update));
+	connect(window, &Window::thumbnailChanged, this, static_cast<void(TabHandleWidget::*)()>(&TabHandleWidget::update));
 	connect(window, &Window::loadingStateChanged, this, &TabHandleWidget::handleLoadingStateChanged);
 	connect(parent, &TabBarWidget::currentChanged, this, &TabHandleWidget::updateGeometries);
 	connect(parent, &TabBarWidget::tabsAmountChanged, this, &TabHandleWidget::updateGeometries);
@@ -155,7 +156,7 @@ void TabHandleWidget::paintEvent(QPaintEvent *event)
 
 	if (m_thumbnailRectangle.isValid())
 	{
-		const QPixmap thumbnail(m_window->createThumbnail());
+		const QPixmap thumbnail(m_window->getThumbnail(m_thumbnailRectangle.size()));
 
 		if (thumbnail.isNull())
 		{
@@ -904,7 +905,7 @@ void TabBarWidget::mouseMoveEvent(QMouseEvent *event)
 
 		if (mainWindow)
 		{
-			const Window *window(mainWindow->getWindowByIdentifier(m_draggedWindow));
+			Window *window(mainWindow->getWindowByIdentifier(m_draggedWindow));
 
 			if (window)
 			{
@@ -914,7 +915,7 @@ void TabBarWidget::mouseMoveEvent(QMouseEvent *event)
 				mimeData->setProperty("x-url-title", window->getTitle());
 				mimeData->setProperty("x-window-identifier", window->getIdentifier());
 
-				const QPixmap thumbnail(window->createThumbnail());
+				const QPixmap thumbnail(window->getThumbnail({}, true));
 				QDrag *drag(new QDrag(this));
 				drag->setMimeData(mimeData);
 				drag->setPixmap(thumbnail.isNull() ? window->getIcon().pixmap(16, 16) : thumbnail);
@@ -1302,7 +1303,7 @@ void TabBarWidget::showPreview(int index, int delay)
 
 		const bool isActive(index == currentIndex());
 
-		m_previewWidget->setPreview(window->getTitle(), ((isActive || m_areThumbnailsEnabled) ? QPixmap() : window->createThumbnail()), isActive);
+		m_previewWidget->setPreview(window->getTitle(), ((isActive || m_areThumbnailsEnabled) ? QPixmap() : window->getThumbnail({}, true)), isActive);
 
 		switch (shape())
 		{
@@ -191,7 +191,7 @@ void TabSwitcherWidget::handleIndexClicked(const QModelIndex &index)
 
 void TabSwitcherWidget::handleCurrentTabChanged(const QModelIndex &index)
 {
-	const Window *window(m_mainWindow->getWindowByIdentifier(index.data(IdentifierRole).toULongLong()));
+	Window *window(m_mainWindow->getWindowByIdentifier(index.data(IdentifierRole).toULongLong()));
 
 	m_previewLabel->setMovie(nullptr);
 	m_previewLabel->setPixmap({});
@@ -233,7 +233,7 @@ void TabSwitcherWidget::handleCurrentTabChanged(const QModelIndex &index)
 			m_spinnerAnimation->stop();
 		}
 
-		m_previewLabel->setPixmap((window->getLoadingState() == WebWidget::CrashedLoadingState) ? ThemesManager::createIcon(QLatin1String("tab-crashed")).pixmap(32, 32) : window->createThumbnail());
+		m_previewLabel->setPixmap((window->getLoadingState() == WebWidget::CrashedLoadingState) ? ThemesManager::createIcon(QLatin1String("tab-crashed")).pixmap(32, 32) : window->getThumbnail({}, true));
 	}
 }
 
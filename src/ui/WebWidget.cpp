@@ -1507,6 +1507,11 @@ QVector<NetworkManager::ResourceInformation> WebWidget::getBlockedRequests() con
 	return {};
 }
 
+QVector<NetworkManager::RequestTiming> WebWidget::getRequestTimings() const
+{
+	return {};
+}
+
 QHash<int, QVariant> WebWidget::getOptions() const
 {
 	return m_options;
@@ -1673,6 +1678,16 @@ quint64 WebWidget::getWindowIdentifier() const
 	return m_windowIdentifier;
 }
 
+qint64 WebWidget::getEstimatedMemoryUsage() const
+{
+	if (getLoadingState() == DeferredLoadingState)
+	{
+		return 0;
+	}
+
+	return (qMax(0LL, getPageInformation(TotalBytesReceivedInformation).toLongLong()) + (static_cast<qint64>(width()) * height() * 4));
+}
+
 int WebWidget::getAmountOfDeferredPlugins() const
 {
 	return 0;
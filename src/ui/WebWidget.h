@@ -247,12 +247,14 @@ public:
 	virtual QVector<LinkUrl> getLinks() const;
 	virtual QVector<LinkUrl> getSearchEngines() const;
 	virtual QVector<NetworkManager::ResourceInformation> getBlockedRequests() const;
+	virtual QVector<NetworkManager::RequestTiming> getRequestTimings() const;
 	QHash<int, QVariant> getOptions() const;
 	virtual QMap<QByteArray, QByteArray> getHeaders() const;
 	virtual QMultiMap<QString, QString> getMetaData() const;
 	virtual ContentStates getContentState() const;
 	virtual LoadingState getLoadingState() const = 0;
 	quint64 getWindowIdentifier() const;
+	virtual qint64 getEstimatedMemoryUsage() const;
 	virtual int getZoom() const = 0;
 	bool hasOption(int identifier) const;
 	virtual bool hasSelection() const;
@@ -25,11 +25,16 @@
 
 #include "ui_WebsiteInformationDialog.h"
 
+#include <QtCore/QSaveFile>
+#include <QtWidgets/QMessageBox>
+
 namespace Otter
 {
 
 WebsiteInformationDialog::WebsiteInformationDialog(WebWidget *widget, QWidget *parent) : Dialog(parent),
 	m_sslInformation(widget->getSslInformation()),
+	m_requestTimings(widget->getRequestTimings()),
+	m_title(widget->getTitle()),
 	m_ui(new Ui::WebsiteInformationDialog)
 {
 	m_ui->setupUi(this);
@@ -224,6 +229,48 @@ WebsiteInformationDialog::WebsiteInformationDialog(WebWidget *widget, QWidget *p
 		Application::triggerAction(ActionsManager::WebsitePreferencesAction, {}, this);
 	});
 
+	if (m_requestTimings.isEmpty())
+	{
+		m_ui->tabWidget->setTabEnabled(3, false);
+	}
+	else
+	{
+		QStandardItemModel *requestsModel(new QStandardItemModel(this));
+		const qint64 startTime(m_requestTimings.first().queuedTime);
+
+		for (int i = 0; i < m_requestTimings.count(); ++i)
+		{
+			const NetworkManager::RequestTiming &timing(m_requestTimings.at(i));
+			QString status;
+
+			if (timing.isBlocked)
+			{
+				status = tr("Blocked");
+			}
+			else if (timing.statusCode > 0)
+			{
+				status = (timing.isCached ? tr("%1 (cached)").arg(timing.statusCode) : QString::number(timing.statusCode));
+			}
+
+			const qint64 responseTime((timing.responseTime < 0) ? timing.finishedTime : timing.responseTime);
+			QList<QStandardItem*> items({new QStandardItem(timing.url.toDisplayString()), new QStandardItem(status), new QStandardItem((timing.bytesReceived > 0) ? Utils::formatUnit(timing.bytesReceived, false, 1) : QString()), new QStandardItem(tr("%1 ms").arg(timing.queuedTime - startTime)), new QStandardItem((responseTime < 0) ? QString() : tr("%1 ms").arg(responseTime - timing.queuedTime)), new QStandardItem((timing.finishedTime < 0) ? QString() : tr("%1 ms").arg(timing.finishedTime - timing.queuedTime))});
+			items[0]->setToolTip(timing.isBlocked ? tr("Blocked by rule: %1").arg(timing.rule) : items[0]->text());
+
+			for (int j = 0; j < items.count(); ++j)
+			{
+				items[j]->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+			}
+
+			requestsModel->appendRow(items);
+		}
+
+		m_ui->requestsViewWidget->setModel(requestsModel);
+
+		updateRequestsHeaderLabels();
+
+		connect(m_ui->exportRequestsButton, &QPushButton::clicked, this, &WebsiteInformationDialog::exportRequests);
+	}
+
 	if (m_sslInformation.certificates.isEmpty())
 	{
 		m_ui->tabWidget->setTabEnabled(2, false);
@@ -279,6 +326,38 @@ WebsiteInformationDialog::~WebsiteInformationDialog()
 	delete m_ui;
 }
 
+void WebsiteInformationDialog::exportRequests()
+{
+	QString fileName(m_requestTimings.first().url.host());
+
+	if (fileName.isEmpty())
+	{
+		fileName = QLatin1String("requests");
+	}
+
+	const SaveInformation information(Utils::getSavePath(fileName + QLatin1String(".har"), {}, {tr("HTTP Archive files (*.har)")}));
+
+	if (!information.canSave)
+	{
+		return;
+	}
+
+	QSaveFile file(information.path);
+
+	if (!file.open(QIODevice::WriteOnly) || file.write(NetworkManager::createHar(m_requestTimings, m_title)) < 0 || !file.commit())
+	{
+		QMessageBox::critical(this, tr("Error"), tr("Failed to export requests:\n%1").arg(file.errorString()), QMessageBox::Close);
+	}
+}
+
+void WebsiteInformationDialog::updateRequestsHeaderLabels()
+{
+	if (m_ui->requestsViewWidget->getSourceModel())
+	{
+		m_ui->requestsViewWidget->getSourceModel()->setHorizontalHeaderLabels({tr("Address"), tr("Status"), tr("Size"), tr("Start"), tr("Waiting"), tr("Duration")});
+	}
+}
+
 void WebsiteInformationDialog::changeEvent(QEvent *event)
 {
 	QDialog::changeEvent(event);
@@ -291,6 +370,8 @@ void WebsiteInformationDialog::changeEvent(QEvent *event)
 		{
 			m_ui->sslErrorsViewWidget->getSourceModel()->setHorizontalHeaderLabels({tr("Error Message"), tr("URL")});
 		}
+
+		updateRequestsHeaderLabels();
 	}
 }
 
@@ -41,9 +41,13 @@ public:
 
 protected:
 	void changeEvent(QEvent *event) override;
+	void exportRequests();
+	void updateRequestsHeaderLabels();
 
 private:
 	WebWidget::SslInformation m_sslInformation;
+	QVector<NetworkManager::RequestTiming> m_requestTimings;
+	QString m_title;
 	Ui::WebsiteInformationDialog *m_ui;
 };
 
@@ -34,6 +34,9 @@
 #include <QtGui/QPainter>
 #include <QtWidgets/QBoxLayout>
 
+#define THUMBNAIL_SCALED_VARIANTS_LIMIT 4
+#define THUMBNAIL_UPDATE_INTERVAL 1000
+
 namespace Otter
 {
 
@@ -66,8 +69,11 @@ Window::Window(const QVariantMap &parameters, ContentsWidget *widget, MainWindow
 	m_parameters(parameters),
 	m_identifier(++m_identifierCounter),
 	m_suspendTimer(0),
+	m_thumbnailTimer(0),
 	m_isAboutToClose(false),
-	m_isPinned(false)
+	m_isPinned(false),
+	m_isThumbnailOutdated(true),
+	m_isThumbnailRequested(false)
 {
 	QBoxLayout *layout(new QBoxLayout(QBoxLayout::TopToBottom, this));
 	layout->setContentsMargins(0, 0, 0, 0);
@@ -81,6 +87,20 @@ Window::Window(const QVariantMap &parameters, ContentsWidget *widget, MainWindow
 	}
 
 	connect(this, &Window::titleChanged, this, &Window::setWindowTitle);
+	connect(this, &Window::titleChanged, this, &Window::handleHistoryChanged);
+	connect(this, &Window::urlChanged, this, &Window::handleHistoryChanged);
+	connect(this, &Window::loadingStateChanged, this, &Window::handleHistoryChanged);
+	connect(this, &Window::optionChanged, this, &Window::markAsModified);
+	connect(this, &Window::zoomChanged, this, &Window::markAsModified);
+	connect(this, &Window::isPinnedChanged, this, &Window::markAsModified);
+	connect(this, &Window::loadingStateChanged, this, [&](WebWidget::LoadingState state)
+	{
+		if (state == WebWidget::FinishedLoadingState)
+		{
+			scheduleThumbnailUpdate();
+		}
+	});
+	connect(this, &Window::zoomChanged, this, &Window::scheduleThumbnailUpdate);
 	connect(mainWindow, &MainWindow::toolBarStateChanged, this, &Window::handleToolBarStateChanged);
 }
 
@@ -94,6 +114,14 @@ void Window::timerEvent(QTimerEvent *event)
 
 		triggerAction(ActionsManager::SuspendTabAction);
 	}
+	else if (event->timerId() == m_thumbnailTimer)
+	{
+		killTimer(m_thumbnailTimer);
+
+		m_thumbnailTimer = 0;
+
+		updateThumbnail();
+	}
 }
 
 void Window::hideEvent(QHideEvent *event)
@@ -106,6 +134,8 @@ void Window::hideEvent(QHideEvent *event)
 	{
 		m_suspendTimer = startTimer(suspendTime * 1000);
 	}
+
+	scheduleThumbnailUpdate();
 }
 
 void Window::focusInEvent(QFocusEvent *event)
@@ -284,6 +314,26 @@ void Window::handleToolBarStateChanged(int identifier, const Session::MainWindow
 	}
 }
 
+void Window::handleHistoryChanged()
+{
+	SessionsManager::journalWindowHistory(this);
+}
+
+void Window::scheduleThumbnailUpdate()
+{
+	m_isThumbnailOutdated = true;
+
+	if (m_isThumbnailRequested && m_thumbnailTimer == 0 && m_contentsWidget && !m_isAboutToClose)
+	{
+		m_thumbnailTimer = startTimer(THUMBNAIL_UPDATE_INTERVAL);
+	}
+}
+
+void Window::markAsModified()
+{
+	SessionsManager::markWindowAsModified(m_identifier);
+}
+
 void Window::updateFocus()
 {
 	QTimer::singleShot(100, this, [&]()
@@ -304,7 +354,9 @@ void Window::updateFocus()
 void Window::setSession(const Session::Window &session, bool deferLoading)
 {
 	m_session = session;
+	m_lastActivity = session.lastActivity;
 
+	markAsModified();
 	setPinned(session.isPinned);
 
 	if (deferLoading)
@@ -334,8 +386,6 @@ void Window::setOption(int identifier, const QVariant &value)
 			m_session.options[identifier] = value;
 		}
 
-		SessionsManager::markSessionAsModified();
-
 		emit optionChanged(identifier, value);
 	}
 }
@@ -420,6 +470,21 @@ void Window::setPinned(bool isPinned)
 	}
 }
 
+void Window::updateThumbnail()
+{
+	if (!m_contentsWidget || m_isAboutToClose || m_contentsWidget->getLoadingState() == WebWidget::DeferredLoadingState)
+	{
+		return;
+	}
+
+	m_thumbnail = m_contentsWidget->createThumbnail();
+	m_isThumbnailOutdated = false;
+
+	m_scaledThumbnails.clear();
+
+	emit thumbnailChanged();
+}
+
 void Window::setContentsWidget(ContentsWidget *widget)
 {
 	if (m_contentsWidget)
@@ -441,6 +506,8 @@ void Window::setContentsWidget(ContentsWidget *widget)
 			m_addressBarWidget = nullptr;
 		}
 
+		markAsModified();
+
 		emit actionsStateChanged();
 
 		return;
@@ -592,9 +659,65 @@ QIcon Window::getIcon() const
 	return ((m_contentsWidget && !m_isAboutToClose) ? m_contentsWidget->getIcon() : HistoryManager::getIcon(m_session.getUrl()));
 }
 
-QPixmap Window::createThumbnail() const
+QPixmap Window::getThumbnail(const QSize &size, bool canRender)
 {
-	return ((m_contentsWidget && !m_isAboutToClose) ? m_contentsWidget->createThumbnail() : QPixmap());
+	m_isThumbnailRequested = true;
+
+	if (m_thumbnail.isNull() && m_isThumbnailOutdated)
+	{
+		if (m_thumbnailTimer != 0)
+		{
+			killTimer(m_thumbnailTimer);
+
+			m_thumbnailTimer = 0;
+		}
+
+		if (canRender)
+		{
+			updateThumbnail();
+		}
+		else if (m_contentsWidget && !m_isAboutToClose)
+		{
+			m_thumbnailTimer = startTimer(0);
+		}
+	}
+
+	if (m_isThumbnailOutdated && m_thumbnailTimer == 0)
+	{
+		scheduleThumbnailUpdate();
+	}
+
+	if (m_thumbnail.isNull() || m_isAboutToClose)
+	{
+		return {};
+	}
+
+	const QSize targetSize(size * m_thumbnail.devicePixelRatio());
+
+	if (targetSize.isEmpty() || (targetSize.width() >= m_thumbnail.width() && targetSize.height() >= m_thumbnail.height()))
+	{
+		return m_thumbnail;
+	}
+
+	for (int i = 0; i < m_scaledThumbnails.count(); ++i)
+	{
+		if (m_scaledThumbnails.at(i).first == targetSize)
+		{
+			return m_scaledThumbnails.at(i).second;
+		}
+	}
+
+	QPixmap thumbnail(m_thumbnail.scaled(targetSize, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
+	thumbnail.setDevicePixelRatio(m_thumbnail.devicePixelRatio());
+
+	if (m_scaledThumbnails.count() >= THUMBNAIL_SCALED_VARIANTS_LIMIT)
+	{
+		m_scaledThumbnails.removeFirst();
+	}
+
+	m_scaledThumbnails.append({targetSize, thumbnail});
+
+	return thumbnail;
 }
 
 QDateTime Window::getLastActivity() const
@@ -691,6 +814,7 @@ Session::Window Window::getSession() const
 		session = m_session;
 	}
 
+	session.lastActivity = m_lastActivity;
 	session.isAlwaysOnTop = windowFlags().testFlag(Qt::WindowStaysOnTopHint);
 	session.state.state = Qt::WindowMaximized;
 
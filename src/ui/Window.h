@@ -65,7 +65,7 @@ public:
 	QVariant getOption(int identifier) const;
 	QUrl getUrl() const;
 	QIcon getIcon() const;
-	QPixmap createThumbnail() const;
+	QPixmap getThumbnail(const QSize &size = {}, bool canRender = false);
 	QDateTime getLastActivity() const;
 	ActionsManager::ActionDefinition::State getActionState(int identifier, const QVariantMap &parameters = {}) const override;
 	Session::Window::History getHistory() const;
@@ -96,24 +96,33 @@ protected:
 	void hideEvent(QHideEvent *event) override;
 	void focusInEvent(QFocusEvent *event) override;
 	void updateFocus();
+	void updateThumbnail();
 	void setContentsWidget(ContentsWidget *widget);
 
 protected slots:
 	void handleSearchRequest(const QString &query, const QString &searchEngine, SessionsManager::OpenHints hints = SessionsManager::DefaultOpen);
 	void handleGeometryChangeRequest(const QRect &geometry);
 	void handleToolBarStateChanged(int identifier, const Session::MainWindow::ToolBarState &state);
+	void handleHistoryChanged();
+	void scheduleThumbnailUpdate();
+	void markAsModified();
 
 private:
 	MainWindow *m_mainWindow;
 	WindowToolBarWidget *m_addressBarWidget;
 	QPointer<ContentsWidget> m_contentsWidget;
 	QDateTime m_lastActivity;
+	QPixmap m_thumbnail;
+	QVector<QPair<QSize, QPixmap> > m_scaledThumbnails;
 	Session::Window m_session;
 	QVariantMap m_parameters;
 	quint64 m_identifier;
 	int m_suspendTimer;
+	int m_thumbnailTimer;
 	bool m_isAboutToClose;
 	bool m_isPinned;
+	bool m_isThumbnailOutdated;
+	bool m_isThumbnailRequested;
 
 	static quint64 m_identifierCounter;
 
@@ -129,6 +138,7 @@ signals:
 	void titleChanged(const QString &title);
 	void urlChanged(const QUrl &url, bool force);
 	void iconChanged(const QIcon &icon);
+	void thumbnailChanged();
 	void requestBlocked(const NetworkManager::ResourceInformation &request);
 	void actionsStateChanged();
 	void arbitraryActionsStateChanged(const QVector<int> &identifiers);